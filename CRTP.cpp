@@ -0,0 +1,165 @@
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+
+//--------------------------------------------------
+//CURIOUSLY RECURRING TEMPLATE PATTERN
+//--------------------------------------------------
+
+//The curiously recurring template pattern (CRTP) is when a class derives from a class template that was instantiated with the derived class itself:
+
+template<typename Derived>
+struct Base{
+    void interface(){static_cast<Derived*>(this)->implementation();}
+};
+
+struct Derived1: public Base<Derived1>{
+    void implementation(){std::cout << "Derived1 implementation called\n";}
+};
+
+//This looks like it shouldn't work, since Derived1 is incomplete when Base<Derived1> is instantiated.
+//However, the body of a member function of a class template isn't instantiated until the function is used.
+//By the time anyone calls interface(), Derived1 is complete, so the static_cast and the call to implementation() are fine.
+
+//The point of this is that the base class knows the exact type of the derived class at compile time.
+//It's similar to a virtual function, in that the base class can call a function that the derived class provides.
+//The difference is that the call is resolved at compile time, so there's no vtable, no indirect call, and the compiler is free to inline it.
+//The downside is that there's no common base class: Base<Derived1> and Base<Derived2> are completely unrelated types,
+//so you can't store different derived classes in the same container through a pointer to the base.
+
+//Something to watch out for is accidentally passing the wrong class to the base:
+//    struct Derived2: public Base<Derived1>{};
+//This compiles, but calling interface() on a Derived2 casts it to a Derived1, which is undefined behavior.
+
+
+
+//--------------------------------------------------
+//ITERATOR FACADES
+//--------------------------------------------------
+
+//A common use of CRTP is to write a lot of boilerplate in terms of a few functions provided by the derived class.
+//Iterators are a good example. A random access iterator needs *, ->, [], ++ and -- (both prefix and postfix), += and -=,
+//+ and - with an integer, - between two iterators, all six comparisons, and five member types.
+//However, every one of those can be written in terms of just a handful of operations.
+//The facade below generates the whole interface out of these functions in the derived class:
+//    dereference() returns a reference to the current element
+//    increment() and decrement() move forward and backward one element
+//    advance(n) moves n elements
+//    distance_to(other) returns how many elements away other is
+//    equal(other) checks if two iterators point to the same element
+
+template<typename Derived, typename Value, typename Category>
+class iterator_facade{
+public:
+
+    using value_type = std::remove_cv_t<Value>;
+    using reference = Value&;
+    using pointer = Value*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = Category;
+
+    reference operator*() const {return derived().dereference();}
+    pointer operator->() const {return &derived().dereference();}
+    reference operator[](difference_type n) const {return *(derived() + n);}
+
+    Derived& operator++(){derived().increment(); return derived();}
+    Derived operator++(int){Derived copy = derived(); derived().increment(); return copy;}
+    Derived& operator--(){derived().decrement(); return derived();}
+    Derived operator--(int){Derived copy = derived(); derived().decrement(); return copy;}
+
+    Derived& operator+=(difference_type n){derived().advance(n); return derived();}
+    Derived& operator-=(difference_type n){derived().advance(-n); return derived();}
+
+    friend Derived operator+(Derived it, difference_type n){it += n; return it;}
+    friend Derived operator+(difference_type n, Derived it){it += n; return it;}
+    friend Derived operator-(Derived it, difference_type n){it -= n; return it;}
+    friend difference_type operator-(const Derived& lhs, const Derived& rhs){return distance(rhs, lhs);}
+
+    friend bool operator==(const Derived& lhs, const Derived& rhs){return equal(lhs, rhs);}
+    friend bool operator!=(const Derived& lhs, const Derived& rhs){return !equal(lhs, rhs);}
+    friend bool operator<(const Derived& lhs, const Derived& rhs){return distance(lhs, rhs) > 0;}
+    friend bool operator>(const Derived& lhs, const Derived& rhs){return rhs < lhs;}
+    friend bool operator<=(const Derived& lhs, const Derived& rhs){return !(rhs < lhs);}
+    friend bool operator>=(const Derived& lhs, const Derived& rhs){return !(lhs < rhs);}
+
+private:
+    Derived& derived(){return static_cast<Derived&>(*this);}
+    const Derived& derived() const {return static_cast<const Derived&>(*this);}
+
+    static difference_type distance(const Derived& from, const Derived& to){return from.distance_to(to);}
+    static bool equal(const Derived& lhs, const Derived& rhs){return lhs.equal(rhs);}
+};
+
+//The friend functions are defined inside the class, so each instantiation of iterator_facade defines its own set of them.
+//They can only be found through argument dependent lookup (since they're never declared outside the class), which means
+//they're only considered when one of the arguments is actually one of these iterators. These are sometimes called hidden friends.
+//Being a friend of iterator_facade doesn't make them friends of Derived, so they go through the private static functions
+//distance and equal, since the derived class is only going to give access to its hooks to the facade itself.
+//Like in Base, none of the member functions are instantiated until they're used. This means that a forward iterator
+//doesn't need to provide decrement, advance, or distance_to, as long as nobody tries to use --, +=, -, or <.
+
+//Here's a random access iterator made with the facade. It walks over every Stride'th element of an array:
+
+template<typename T, std::ptrdiff_t Stride = 1>
+class stride_iterator: public iterator_facade<stride_iterator<T, Stride>, T, std::random_access_iterator_tag>{
+public:
+
+    stride_iterator() = default;
+    explicit stride_iterator(T* p): ptr(p){}
+
+private:
+    friend class iterator_facade<stride_iterator<T, Stride>, T, std::random_access_iterator_tag>;
+
+    T& dereference() const {return *ptr;}
+    void increment(){ptr += Stride;}
+    void decrement(){ptr -= Stride;}
+    void advance(std::ptrdiff_t n){ptr += n * Stride;}
+    std::ptrdiff_t distance_to(const stride_iterator& other) const {return (other.ptr - ptr) / Stride;}
+    bool equal(const stride_iterator& other) const {return ptr == other.ptr;}
+
+    T* ptr = nullptr;
+};
+
+//The hooks are private, and iterator_facade is made a friend so that it can still call them.
+//That way, the only interface users of the iterator see is the one the facade generates.
+
+//Since every operator is a template that's instantiated for this exact type, and every hook is a non-virtual function
+//that the compiler can see the definition of, a loop using a stride_iterator<int> compiles to the same code as a loop using an int*.
+//For example, in this function (the same loop as exampleFunc5 from the intro to templates):
+
+template<typename It>
+typename std::iterator_traits<It>::value_type exampleFunc1(It begin, It end){
+    typename std::iterator_traits<It>::value_type max = *begin;
+    for(It it = begin; it != end; ++it){
+        if(max < *it){max = *it;}
+    }
+    return max;
+}
+
+//exampleFunc1(stride_iterator<int>(v.data()), stride_iterator<int>(v.data() + v.size())) and exampleFunc1(v.data(), v.data() + v.size())
+//should produce identical assembly with full optimizations turned on, including vectorizing the loop.
+//You can check this by compiling with -O3 and comparing the output (with -S, or on a site like godbolt.org).
+//At -O2, GCC uses a much more cautious cost model for vectorizing, so whether either loop is vectorized depends on the version and the surrounding code.
+//With a Stride other than 1, the same loop walks over a single column of a row-major matrix.
+//Just make sure the end iterator is a multiple of Stride elements away from the beginning, otherwise != will never be false.
+
+
+
+int main(){
+
+    Derived1 d;
+    d.interface();
+
+    std::vector<int> v = {3, 1, 4, 1, 5, 9, 2, 6};
+
+    stride_iterator<int> begin(v.data()), end(v.data() + v.size());
+    std::cout << exampleFunc1(begin, end) << ' ' << exampleFunc1(v.data(), v.data() + v.size()) << std::endl;
+
+    stride_iterator<int, 2> even_begin(v.data()), even_end(v.data() + v.size());
+    std::cout << exampleFunc1(even_begin, even_end) << ' ' << (even_end - even_begin) << ' ' << even_begin[2] << std::endl;
+
+    return 0;
+}
@@ -1,6 +1,17 @@
 
 #include <iostream>
 #include <vector>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <atomic>
+#include <string_view>
 
 
 //NEED MEMBER TEMPLATES
@@ -22,7 +33,9 @@ struct A{
     
     A(T): var(T()) {} //Constructor which allows type deduction for template parameters.
     
-    A(const A& other): var(other.var) {} //Copy constructor, also allows for type deduction
+    A(const A& other) noexcept(std::is_nothrow_copy_constructible_v<T>): var(other.var) {} //Copy constructor, also allows for type deduction
+    
+    A(A&& other) noexcept(std::is_nothrow_move_constructible_v<T>): var(std::move(other.var)) {} //Move constructor
     
     A operator= (const A& other){} //Copy assignment operator
     
@@ -222,6 +235,533 @@ struct E: public A<T>{
 
 
 
+//--------------------------------------------------
+//STATIC MEMBERS AND ALLOCATORS
+//--------------------------------------------------
+
+//Since every instantiation of a class template has its own static members, you can choose what gets shared by choosing the template parameters.
+//An allocator is a good example. Node based containers like std::list and std::map allocate one node at a time,
+//and every node of a given container has the same size. Allocating each of them with new is slow, since new has to handle every possible size.
+//A slab allocator instead grabs a large block of memory (a slab) and cuts it up into equally sized pieces.
+//If the pool of pieces is a class template with the piece size as its parameter, then every type with the same size and alignment
+//shares one pool. A<int>, D<int>, and any other type that happens to be the same size all use the same slabs.
+
+//First, the size of the pieces and how many fit in a slab are computed from the size and alignment:
+
+template<size_t Size, size_t Align>
+struct slab_geometry{
+    static constexpr size_t align = Align > alignof(void*) ? Align : alignof(void*);
+    static constexpr size_t block_size = ((Size > sizeof(void*) ? Size : sizeof(void*)) + align - 1) / align * align;
+    static constexpr size_t blocks_per_slab = block_size * 64 > 65536 ? 64 : 65536 / block_size;
+    static constexpr size_t batch = blocks_per_slab / 4 > 32 ? 32 : (blocks_per_slab / 4 > 0 ? blocks_per_slab / 4 : 1);
+};
+
+//Every block is at least as big as a pointer, because a free block stores a pointer to the next free block inside itself.
+//That way the list of free blocks doesn't need any memory of its own.
+
+template<size_t BlockSize, size_t Align>
+class slab_pool{
+public:
+
+    using geometry = slab_geometry<BlockSize, Align>;
+
+    static void* allocate(){
+        thread_cache temp;
+        thread_cache& cache = local(temp);
+        if(!cache.head){refill(cache);}
+        free_block* block = cache.head;
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    static void deallocate(void* p){
+        thread_cache temp;
+        thread_cache& cache = local(temp);
+        free_block* block = static_cast<free_block*>(p);
+        block->next = cache.head;
+        cache.head = block;
+        if(++cache.count >= 2 * geometry::batch){release(cache, geometry::batch);}
+    }
+
+private:
+
+    struct free_block{free_block* next;};
+
+    //The shared part of the pool, protected by a mutex. It owns every slab, and holds blocks that threads have given back.
+    struct shared_state{
+        std::mutex mutex;
+        std::vector<void*> slabs;
+        free_block* head = nullptr;
+    };
+
+    //Each thread keeps its own list of free blocks, so most allocations and deallocations don't need to lock anything.
+    struct thread_cache{
+        ~thread_cache(){release(*this, count);}
+
+        free_block* head = nullptr;
+        size_t count = 0;
+    };
+
+    //Created with new and never deleted, so the slabs are still there for containers that are destroyed after it would have been.
+    static shared_state& shared(){
+        static shared_state* state = new shared_state;
+        return *state;
+    }
+
+    //Returns the thread's cache, or temp if the thread's cache has already been destroyed.
+    static thread_cache& local(thread_cache& temp){
+        struct owner{
+            ~owner(){destroyed() = true;}
+            thread_cache cache;
+        };
+        if(destroyed()){return temp;}
+        thread_local owner o;
+        return o.cache;
+    }
+
+    static bool& destroyed(){
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    //Takes a batch of blocks from the shared list, or cuts up a new slab if there aren't any.
+    static void refill(thread_cache& cache){
+        shared_state& state = shared();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if(!state.head){
+            unsigned char* slab = static_cast<unsigned char*>(::operator new(geometry::block_size * geometry::blocks_per_slab, std::align_val_t(geometry::align)));
+            state.slabs.push_back(slab);
+            for(size_t i = geometry::blocks_per_slab; i-- > 0;){
+                free_block* block = reinterpret_cast<free_block*>(slab + i * geometry::block_size);
+                block->next = state.head;
+                state.head = block;
+            }
+        }
+        for(size_t i = 0; i < geometry::batch && state.head; ++i){
+            free_block* block = state.head;
+            state.head = block->next;
+            block->next = cache.head;
+            cache.head = block;
+            ++cache.count;
+        }
+    }
+
+    //Gives count blocks from the thread's list back to the shared list, taking the lock only once for the whole batch.
+    static void release(thread_cache& cache, size_t count){
+        if(count == 0){return;}
+        free_block* first = cache.head;
+        free_block* last = first;
+        for(size_t i = 1; i < count; ++i){last = last->next;}
+        cache.head = last->next;
+        cache.count -= count;
+        shared_state& state = shared();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        last->next = state.head;
+        state.head = first;
+    }
+};
+
+//A block allocated on one thread can be freed on another: it just goes into the freeing thread's cache.
+//When a thread's cache gets too big (like when one thread allocates and another frees), half of it is handed back to the shared list
+//in one batch, so the threads can keep passing blocks to each other without locking for every block.
+//When a thread exits, its cache's destructor gives all of its blocks back.
+//A global container can still be allocating or freeing after that, since it's destroyed after the main thread's thread_local variables.
+//Those calls use a temporary cache instead, which hands its blocks straight back to the shared list when it's destroyed.
+//The slabs themselves are never freed, since a slab can't be freed while any of its blocks are still in use,
+//and there's no point in the program where that's guaranteed. The operating system reclaims them when the program ends.
+
+//Finally, the allocator itself. The standard library's containers accept any type with this interface as an allocator:
+
+template<typename T>
+struct slab_allocator{
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    slab_allocator() = default;
+
+    template<typename U>
+    slab_allocator(const slab_allocator<U>&){}
+
+    T* allocate(size_t n){
+        if(n == 1){return static_cast<T*>(slab_pool<sizeof(T), alignof(T)>::allocate());}
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* p, size_t n){
+        if(n == 1){slab_pool<sizeof(T), alignof(T)>::deallocate(p);}
+        else{::operator delete(p, std::align_val_t(alignof(T)));}
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const slab_allocator<T>&, const slab_allocator<U>&){return true;}
+
+template<typename T, typename U>
+bool operator!=(const slab_allocator<T>&, const slab_allocator<U>&){return false;}
+
+//The converting constructor template is needed because containers don't actually allocate T's.
+//A std::list<A<int>, slab_allocator<A<int>>> allocates list nodes, which hold an A<int> along with the pointers to the next and previous nodes.
+//The list converts the allocator it was given into a slab_allocator<node type>, and that instantiation uses the pool for the node's size.
+//This is another reason the pools are keyed on the size instead of the type: the node types are internal to the standard library,
+//but all that matters is how big they are.
+//Allocations of more than one object (like the array of a std::vector) aren't a good fit for fixed size blocks, so they just use operator new.
+//Since the allocator doesn't have any state of its own, any two slab_allocators are equal, which means memory allocated by one
+//can be freed by any other.
+
+
+
+//--------------------------------------------------
+//TYPE ERASURE WITH CLASS TEMPLATES
+//--------------------------------------------------
+
+//Sometimes you need to store an object without knowing its type at compile time, like an A<T> where T could be anything.
+//std::any does this, but for most types it allocates memory on the heap to hold the object.
+//The class below stores small objects inside itself instead. The only thing it needs to know about the type is how to copy, move,
+//and destroy it, so for each type it stores, it keeps a pointer to a table of functions that do those things.
+//This table is essentially a hand-written vtable. A static member variable template generates one for every type that's stored,
+//and since it's constexpr, all of the tables are built by the compiler.
+
+template<size_t Capacity>
+class small_any{
+public:
+
+    small_any() = default;
+
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, small_any>>>
+    small_any(T&& val){emplace<std::decay_t<T>>(std::forward<T>(val));}
+
+    small_any(const small_any& other): table(other.table){if(table){table->copy(other.storage, storage);}}
+    small_any(small_any&& other) noexcept: table(other.table){
+        if(table){table->move(other.storage, storage);}
+        other.table = nullptr;
+    }
+
+    small_any& operator=(small_any other) noexcept{
+        reset();
+        table = other.table;
+        if(table){table->move(other.storage, storage);}
+        other.table = nullptr;
+        return *this;
+    }
+
+    ~small_any(){reset();}
+
+    bool has_value() const {return table != nullptr;}
+    const std::type_info& type() const {return table ? table->type() : typeid(void);}
+
+    void reset(){
+        if(table){table->destroy(storage);}
+        table = nullptr;
+    }
+
+    //Returns a pointer to the stored object if it's a T, or nullptr otherwise.
+    template<typename T>
+    T* get_if(){return table == &vtable_for<T> ? static_cast<T*>(address<T>(storage)) : nullptr;}
+
+    template<typename T>
+    const T* get_if() const {return const_cast<small_any*>(this)->get_if<T>();}
+
+private:
+
+    //The buffer is always big enough to hold a pointer, which is what's stored when the object doesn't fit.
+    union buffer{
+        alignas(std::max_align_t) unsigned char bytes[Capacity > sizeof(void*) ? Capacity : sizeof(void*)];
+        void* heap;
+    };
+
+    template<typename T>
+    static constexpr bool fits_inline = sizeof(T) <= sizeof(buffer) && alignof(T) <= alignof(buffer) && std::is_nothrow_move_constructible_v<T>;
+
+    template<typename T>
+    static void* address(buffer& b){
+        if constexpr(fits_inline<T>){return b.bytes;}
+        else{return b.heap;}
+    }
+
+    struct vtable{
+        void (*copy)(const buffer& from, buffer& to);
+        void (*move)(buffer& from, buffer& to) noexcept;
+        void (*destroy)(buffer& b) noexcept;
+        const std::type_info& (*type)();
+    };
+
+    template<typename T>
+    static void copyImpl(const buffer& from, buffer& to){
+        const T& val = *static_cast<const T*>(address<T>(const_cast<buffer&>(from)));
+        if constexpr(fits_inline<T>){::new(static_cast<void*>(to.bytes)) T(val);}
+        else{to.heap = new T(val);}
+    }
+
+    template<typename T>
+    static void moveImpl(buffer& from, buffer& to) noexcept{
+        if constexpr(fits_inline<T>){
+            T* val = std::launder(reinterpret_cast<T*>(from.bytes));
+            ::new(static_cast<void*>(to.bytes)) T(std::move(*val));
+            val->~T();
+        }else{
+            to.heap = from.heap;
+        }
+    }
+
+    template<typename T>
+    static void destroyImpl(buffer& b) noexcept{
+        if constexpr(fits_inline<T>){std::launder(reinterpret_cast<T*>(b.bytes))->~T();}
+        else{delete static_cast<T*>(b.heap);}
+    }
+
+    template<typename T>
+    static const std::type_info& typeImpl(){return typeid(T);}
+
+    template<typename T>
+    static constexpr vtable vtable_for = {&copyImpl<T>, &moveImpl<T>, &destroyImpl<T>, &typeImpl<T>};
+
+    template<typename T, typename ...Args>
+    void emplace(Args&&... args){
+        if constexpr(fits_inline<T>){::new(static_cast<void*>(storage.bytes)) T(std::forward<Args>(args)...);}
+        else{storage.heap = new T(std::forward<Args>(args)...);}
+        table = &vtable_for<T>;
+    }
+
+    buffer storage;
+    const vtable* table = nullptr;
+};
+
+//A type is only stored inline if it fits in the buffer, doesn't need stricter alignment than the buffer has,
+//and can be moved without throwing. The last condition is what lets the move constructor be noexcept.
+//Otherwise, the object is put on the heap and the buffer just holds a pointer to it.
+//Either way, moving a small_any never allocates: an inline object is moved into the new buffer, and a heap object's pointer is just handed over.
+//Like std::any, the stored type has to be copyable, since vtable_for<T> always includes a copy function.
+//get_if compares the table pointer instead of comparing type_info objects, since every T has exactly one vtable_for<T>.
+//The pointer comparison is cheaper than comparing type_info, which might have to compare the types' names.
+
+//This is why A's copy and move constructors are marked noexcept whenever copying or moving T can't throw.
+//A user-declared copy constructor stops the compiler from generating a move constructor, and without the noexcept,
+//std::is_nothrow_move_constructible_v<A<T>> would be false for every T, so every A<T> would end up on the heap.
+//The noexcept(condition) form makes the constructor noexcept only for the Ts where that's actually true.
+
+//small_any<32> can hold an A<int>, an A<double>, or an A<std::string> inline (on most 64 bit implementations), but an A<std::array<int, 16>>
+//with a bigger T would have to go on the heap. Choosing Capacity is a tradeoff between how many types fit inline
+//and how much space every small_any takes up, even when it's holding something small.
+
+
+//--------------------------------------------------
+//TRACKING ALLOCATIONS PER TYPE
+//--------------------------------------------------
+
+//Since the standard containers call their allocator for every allocation, an allocator is also a good place to measure how much memory each type is using.
+//The allocator below takes a second template parameter, a tag, which is just an empty struct that names the part of the program using the memory.
+//Every combination of a type and a tag gets its own counters, in the same way that every instantiation of A<T> gets its own static_var.
+
+//To print a report, we need the names of the types. typeid(T).name() returns a mangled name on GCC and Clang,
+//but __PRETTY_FUNCTION__ (and __FUNCSIG__ on MSVC) contains the function's template arguments in readable form,
+//so the name can be cut out of it at compile time:
+
+template<typename T>
+constexpr std::string_view type_name(){
+#if defined(__clang__) || defined(__GNUC__)
+    std::string_view name = __PRETTY_FUNCTION__; //"... type_name() [T = int]" on Clang, "... type_name() [with T = int; ...]" on GCC
+    size_t start = name.find("T = ") + 4;
+    size_t end = name.find(';', start);
+    if(end == std::string_view::npos){end = name.rfind(']');}
+    return name.substr(start, end - start);
+#elif defined(_MSC_VER)
+    std::string_view name = __FUNCSIG__; //"... type_name<int>(void)"
+    size_t start = name.find("type_name<") + 10;
+    return name.substr(start, name.rfind(">(void)") - start);
+#else
+    return "unknown";
+#endif
+}
+
+//The counters for one type and tag are kept in a tracking_stats. Every thread that allocates gets its own shard of counters,
+//so counting allocations never makes two threads write to the same memory. The shards are kept in a linked list that's only ever added to,
+//using compare_exchange, so that a report can read all of them without locking anything.
+//Live and peak bytes are the exception: the peak depends on the total across all threads, so those are shared between the threads.
+
+class tracking_stats{
+public:
+
+    struct shard{
+        std::atomic<unsigned long long> allocations{0};
+        std::atomic<unsigned long long> deallocations{0};
+        std::atomic<bool> in_use{true};
+        shard* next = nullptr;
+    };
+
+    tracking_stats(std::string_view type, std::string_view tag): type(type), tag(tag){
+        next = registry().load(std::memory_order_relaxed);
+        while(!registry().compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)){}
+    }
+
+    //Reuses a shard from a thread that has exited, or adds a new one.
+    shard* claim(){
+        for(shard* s = shards.load(std::memory_order_acquire); s; s = s->next){
+            bool expected = false;
+            if(s->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)){return s;}
+        }
+        shard* s = new shard;
+        s->next = shards.load(std::memory_order_relaxed);
+        while(!shards.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed)){}
+        return s;
+    }
+
+    //Only the thread that owns a shard writes to it, so a plain load and store is enough. fetch_add would work too, but it's slower.
+    static void bump(std::atomic<unsigned long long>& counter){counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);}
+
+    void add_live(long long bytes){
+        long long now = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        long long old_peak = peak.load(std::memory_order_relaxed);
+        while(now > old_peak && !peak.compare_exchange_weak(old_peak, now, std::memory_order_relaxed)){}
+    }
+
+    static std::atomic<tracking_stats*>& registry(){
+        static std::atomic<tracking_stats*> head{nullptr};
+        return head;
+    }
+
+    std::string_view type;
+    std::string_view tag;
+    std::atomic<long long> live{0};
+    std::atomic<long long> peak{0};
+    shard shared_shard; //used by threads whose own shard is gone, so it's never given to a thread
+    std::atomic<shard*> shards{&shared_shard};
+    tracking_stats* next = nullptr;
+};
+
+//allocation_tracker holds the tracking_stats for one type and tag, along with each thread's shard of it.
+//When a thread exits, its shard is marked as unused so the next new thread can take it over, counts and all.
+//That way, a program that keeps starting new threads doesn't keep adding shards.
+//The tracking_stats is created with new and never deleted, since containers in other static objects might still free memory after it would have been destroyed.
+//For the same reason, a global container can allocate or free memory after the main thread's handle has been destroyed, and by then
+//its shard might already belong to another thread. Like in slab_pool, a thread_local flag records that the handle is gone,
+//and those late calls count into the shared shard instead, with fetch_add since more than one thread could be using it.
+
+template<typename T, typename Tag>
+struct allocation_tracker{
+
+    static tracking_stats& stats(){
+        static tracking_stats* s = new tracking_stats(type_name<T>(), type_name<Tag>());
+        return *s;
+    }
+
+    //Returns the thread's shard, or nullptr if the thread's handle has already been destroyed.
+    static tracking_stats::shard* local(){
+        struct handle{
+            ~handle(){
+                destroyed() = true;
+                s->in_use.store(false, std::memory_order_release);
+            }
+            tracking_stats::shard* s = stats().claim();
+        };
+        if(destroyed()){return nullptr;}
+        thread_local handle h;
+        return h.s;
+    }
+
+    static bool& destroyed(){
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    static void on_allocate(size_t bytes){
+        if(tracking_stats::shard* s = local()){tracking_stats::bump(s->allocations);}
+        else{stats().shared_shard.allocations.fetch_add(1, std::memory_order_relaxed);}
+        stats().add_live(static_cast<long long>(bytes));
+    }
+
+    static void on_deallocate(size_t bytes){
+        if(tracking_stats::shard* s = local()){tracking_stats::bump(s->deallocations);}
+        else{stats().shared_shard.deallocations.fetch_add(1, std::memory_order_relaxed);}
+        stats().add_live(-static_cast<long long>(bytes));
+    }
+};
+
+//Every allocation is counted twice: once for its type, and once in the totals for its tag.
+
+struct all_types{};
+
+template<typename T, typename Tag = all_types>
+struct tracking_allocator{
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    tracking_allocator() = default;
+
+    template<typename U>
+    tracking_allocator(const tracking_allocator<U, Tag>&){}
+
+    T* allocate(size_t n){
+        T* p = static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        allocation_tracker<T, Tag>::on_allocate(n * sizeof(T));
+        allocation_tracker<all_types, Tag>::on_allocate(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t n){
+        allocation_tracker<T, Tag>::on_deallocate(n * sizeof(T));
+        allocation_tracker<all_types, Tag>::on_deallocate(n * sizeof(T));
+        ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+};
+
+template<typename T, typename U, typename Tag>
+bool operator==(const tracking_allocator<T, Tag>&, const tracking_allocator<U, Tag>&){return true;}
+
+template<typename T, typename U, typename Tag>
+bool operator!=(const tracking_allocator<T, Tag>&, const tracking_allocator<U, Tag>&){return false;}
+
+//Containers rebind the allocator to their node type, which keeps the tag, since std::allocator_traits replaces only the first template argument.
+//This means a std::list<A<int>, tracking_allocator<A<int>, parser_tag>> shows up in the report as the list's node type, not as A<int>.
+//That's actually useful, since the node is what's really taking up the memory.
+
+//Tags are just empty structs, so you can make one for each part of your program.
+//An alias template makes it easy to switch a vector over to a tracked one (like the vec<T> alias in the alias templates section):
+
+struct parser_tag{};
+struct network_tag{};
+
+template<typename T, typename Tag>
+using tracked_vector = std::vector<T, tracking_allocator<T, Tag>>;
+
+//Finally, the report walks the list of every tracking_stats that has been created and adds up the shards:
+
+struct allocation_record{
+    std::string_view type;
+    std::string_view tag;
+    long long live_bytes;
+    long long peak_bytes;
+    unsigned long long allocations;
+    unsigned long long deallocations;
+};
+
+inline std::vector<allocation_record> allocationReport(){
+    std::vector<allocation_record> records;
+    for(tracking_stats* s = tracking_stats::registry().load(std::memory_order_acquire); s; s = s->next){
+        allocation_record record{s->type, s->tag, s->live.load(std::memory_order_relaxed), s->peak.load(std::memory_order_relaxed), 0, 0};
+        for(tracking_stats::shard* sh = s->shards.load(std::memory_order_acquire); sh; sh = sh->next){
+            record.allocations += sh->allocations.load(std::memory_order_relaxed);
+            record.deallocations += sh->deallocations.load(std::memory_order_relaxed);
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+inline void printAllocationReport(std::ostream& out){
+    for(const allocation_record& r : allocationReport()){
+        out << r.tag << ' ' << r.type << ": " << r.live_bytes << " bytes live, " << r.peak_bytes << " peak, "
+            << r.allocations << " allocations, " << r.deallocations << " deallocations\n";
+    }
+}
+
+//The report can be taken while other threads are allocating. Each number is read atomically, but they're not all read at the same moment,
+//so the counts might be slightly out of step with each other. For finding out which instantiation is using the most memory, that doesn't matter.
+
+
+
 int main(){
 
     
@@ -234,6 +774,19 @@ int main(){
     
     std::cout << A<double>::static_var << ' ' << A<int>::static_var << std::endl;
     
+    std::list<A<int>, slab_allocator<A<int>>> list_1; //The nodes come from slabs shared by every type with the same node size
+    for(int i = 0; i < 1000; ++i){list_1.emplace_back(i);}
+    std::cout << list_1.size() << std::endl;
+    
+    std::vector<small_any<32>> anys; //The A<T> objects are stored inside the small_any, not on the heap
+    anys.emplace_back(A<int>(5));
+    anys.emplace_back(A<double>(1.5));
+    std::cout << (anys[0].get_if<A<int>>() != nullptr) << ' ' << (anys[1].get_if<A<int>>() != nullptr) << std::endl;
+    
+    tracked_vector<int, network_tag> packets(1000);
+    std::list<A<int>, tracking_allocator<A<int>, parser_tag>> list_2(100);
+    printAllocationReport(std::cout);
+    
         
     
     return 0;
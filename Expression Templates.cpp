@@ -0,0 +1,136 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
+
+
+//--------------------------------------------------
+//EXPRESSION TEMPLATES
+//--------------------------------------------------
+
+//In the template specialization section, A<const char*> stored its string literal as a std::string.
+//Suppose you wanted to build that std::string out of a bunch of pieces, like this:
+//    std::string s = std::string("Hello") + ", " + name + "! You have " + std::to_string(count) + " messages";
+//Each + creates a new std::string, which means that every piece causes another allocation and copies all of the characters
+//that came before it again. The longer the chain, the worse this gets.
+
+//Expression templates get around this by making operators return an object that describes the operation instead of performing it.
+//The type of that object is a template built out of the types of its operands, so the whole expression is recorded in one
+//(possibly very long) type, like concat<concat<string_piece, string_piece>, int_piece>.
+//Nothing is actually computed until the result is needed. At that point, the entire expression is known,
+//so it can be evaluated in the most efficient way, which in this case means figuring out the final length first,
+//allocating once, and then copying each piece directly into place.
+
+
+//The leaves of the expression are the pieces that aren't made out of other pieces.
+//Anything that can be viewed as a std::string_view (string literals, std::string, std::string_view) is stored as a string_piece.
+//string_piece doesn't own its characters, so the strings it refers to need to stay alive until the expression is evaluated.
+
+struct string_piece{
+    constexpr size_t size() const {return str.size();}
+    char* write(char* out) const {return str.copy(out, str.size()) + out;}
+
+    std::string_view str;
+};
+
+//Integers are stored by value and are only converted to characters when the expression is evaluated.
+//Counting the digits ahead of time lets them take part in computing the final length just like the strings.
+
+template<typename T>
+struct int_piece{
+    constexpr size_t size() const {
+        size_t digits = val < 0 ? 2 : 1;
+        for(T rest = val / 10; rest != 0; rest /= 10){++digits;}
+        return digits;
+    }
+    char* write(char* out) const {return std::to_chars(out, out + size(), val).ptr;}
+
+    T val;
+};
+
+//A concat is a node in the expression holding the two operands of a +.
+//Since the operands can be other concats, size and write just recurse down the tree.
+
+template<typename L, typename R>
+struct concat{
+    constexpr size_t size() const {return left.size() + right.size();}
+    char* write(char* out) const {return right.write(left.write(out));}
+
+    std::string str() const {
+        std::string result(size(), '\0');
+        write(result.data());
+        return result;
+    }
+    operator std::string() const {return str();}
+
+    L left;
+    R right;
+};
+
+
+//Now we need a way to turn an operand into the right kind of node. Overloading a function like this works well:
+
+inline string_piece to_piece(std::string_view str){return {str};}
+
+template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+int_piece<T> to_piece(T val){return {val};}
+
+inline string_piece to_piece(const string_piece& piece){return piece;}
+
+template<typename T>
+int_piece<T> to_piece(const int_piece<T>& piece){return piece;}
+
+template<typename L, typename R>
+concat<L, R> to_piece(const concat<L, R>& node){return node;}
+
+//The std::enable_if_t on the integer overload stops it from taking bools and chars, since neither of those should be printed as numbers.
+//std::enable_if will be covered in its own section, but for now, just know that it removes the overload when the condition is false.
+
+//Finally, the operator+ builds the node. It should only be used when at least one side is already part of an expression.
+//Otherwise, it would hijack things like std::string + std::string, which would be surprising.
+
+template<typename T>
+struct is_piece{static constexpr bool value = false;};
+
+template<>
+struct is_piece<string_piece>{static constexpr bool value = true;};
+
+template<typename T>
+struct is_piece<int_piece<T>>{static constexpr bool value = true;};
+
+template<typename L, typename R>
+struct is_piece<concat<L, R>>{static constexpr bool value = true;};
+
+template<typename L, typename R, typename = std::enable_if_t<is_piece<L>::value || is_piece<R>::value>>
+auto operator+(const L& left, const R& right){
+    return concat<decltype(to_piece(left)), decltype(to_piece(right))>{to_piece(left), to_piece(right)};
+}
+
+//To start an expression, you turn the first operand into a piece yourself:
+//    std::string s = to_piece("Hello") + ", " + name + "! You have " + count + " messages";
+//The type of the right hand side is concat<concat<concat<concat<concat<string_piece, string_piece>, string_piece>, string_piece>, int_piece<int>>, string_piece>.
+//Converting it to a std::string calls size() once on the whole tree, allocates exactly that many characters,
+//then has each leaf write its characters directly to where they belong.
+//Since all of the node types are known at compile time, the compiler can inline all of the recursive calls,
+//so there's no overhead from the tree structure itself.
+
+//The main danger with expression templates is keeping the expression around instead of evaluating it right away.
+//If you wrote
+//    auto expr = to_piece("Hello, ") + std::string("world");
+//Then the std::string would be destroyed at the end of the line and expr would contain a dangling std::string_view.
+//Using a concrete type like std::string for the result, instead of auto, avoids this.
+
+
+
+int main(){
+
+    std::string name = "Alice";
+    int count = -42;
+
+    std::string s = to_piece("Hello") + ", " + name + "! You have " + count + " messages";
+
+    std::cout << s << std::endl;
+
+    return 0;
+}
@@ -1,6 +1,28 @@
 #include <iostream>
 #include <vector>
 #include<string>
+#include <tuple>
+#include <optional>
+#include <type_traits>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <memory>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <x86intrin.h>
+#endif
 
 //This code can be used to print out the value category of an expression.
 template<typename T>
@@ -74,7 +96,7 @@ int foo(int&){std::cout << "lvalue\n"; return 0;}
 int foo(int&&){std::cout << "rvalue\n"; return 0;}
 
 template<typename T>
-void exampleFunc3(T&& val){bar(std::forward<T>(val));}
+constexpr void exampleFunc3(T&& val){bar(std::forward<T>(val));}
 
 //Given the above functions, if you write
 //    exampleFunc3(5);
@@ -112,15 +134,575 @@ void exampleFunc4(Ts&&... vals){
 
 
 
+//--------------------------------------------------
+//DEFERRED CALLS
+//--------------------------------------------------
+
+//The type deduction of forwarding references can also be used to decide how something should be stored.
+//Suppose you want to bundle up a function and its arguments, and only call the function later on if the result is actually needed.
+//If an argument is an lvalue, you probably want to keep a reference to it, since the caller still owns it and
+//copying it could be expensive. If an argument is an rvalue, you can't keep a reference to it,
+//since the temporary will be destroyed at the end of the full expression, so you have to move it into the bundle.
+//This is exactly the information the deduced type of a forwarding reference gives you.
+//If the argument is an lvalue of type int, Ts is deduced as int&. If it's an rvalue, Ts is just deduced as int.
+//So if you store the arguments in a std::tuple<Ts...>, lvalues will be stored as references and rvalues will be stored by value.
+//Note that the constructor's Ts&& is not a forwarding reference, since Ts belongs to the class (like x in A::foo).
+//It doesn't need to be one though: Ts has already been deduced by defer, so reference collapsing turns it into int& or int&& as appropriate.
+
+template<typename F, typename ...Ts>
+class deferred{
+public:
+
+    using result_type = std::invoke_result_t<F&, Ts&&...>;
+    static_assert(!std::is_void_v<result_type>, "a deferred call needs a result to remember");
+    static_assert(!std::is_reference_v<result_type>, "a deferred call can't remember a reference; return by value or wrap it in std::ref");
+
+    deferred(F f, Ts&&... vals): func(std::move(f)), args(std::forward<Ts>(vals)...){}
+
+    result_type& operator()(){
+        if(!result){result.emplace(std::apply(func, std::move(args)));}
+        return *result;
+    }
+
+    bool evaluated() const {return result.has_value();}
+
+private:
+    F func;
+    std::tuple<Ts...> args;
+    std::optional<result_type> result;
+};
+
+template<typename F, typename ...Ts>
+deferred<std::decay_t<F>, Ts...> defer(F&& f, Ts&&... vals){
+    return deferred<std::decay_t<F>, Ts...>(std::forward<F>(f), std::forward<Ts>(vals)...);
+}
+
+//The function is only called the first time operator() is used, and the result is kept around for every call after that.
+//This means that if you never ask for the result, the arguments are never used and the function is never called.
+//Since the function is only ever called once, it's safe to std::move the tuple into std::apply.
+//std::get on an rvalue tuple returns an rvalue reference for the elements stored by value,
+//but it still returns an lvalue reference for the elements that are references.
+//In other words, each argument reaches the function with the same value category it had when defer was called,
+//just like if you had used std::forward. If you wrote this:
+//    auto d = defer([](int& x, int&& y){return x + y;}, a, 5);
+//The lambda isn't called until you write d(), and x refers to a itself while y refers to the copy of 5 stored in d.
+//Keep in mind that because lvalues are stored as references, d must not outlive the variables you passed to it.
+
+//The function's return type can't be void, because std::optional<void> isn't allowed.
+//A deferred call that doesn't return anything also doesn't have anything to remember, so you can just call the function directly instead.
+//The return type can't be a reference either, since std::optional<T&> isn't allowed. Even if it were, remembering a reference
+//would just mean remembering where the real result lives, and that object could be gone by the time you call d() again.
+//If you really do want to keep a reference, return a std::reference_wrapper (with std::ref) so that this choice is written down.
+
+
+
+//--------------------------------------------------
+//CHECKING FORWARDING AT COMPILE TIME
+//--------------------------------------------------
+
+//Mistakes with forwarding usually don't cause build errors. If you forget to write std::forward, the function still compiles,
+//it just copies the argument where it could have moved it. If you forward the same argument twice, the second use
+//might get an object that has already been moved from.
+//There's no trait that can look inside the body of a function, but you can still catch these mistakes at compile time
+//by calling the function inside a constant expression with an argument that keeps track of what happens to it.
+
+struct probe_log{
+    int copies = 0;
+    int moves = 0;
+    int lvalue_uses = 0;
+    int rvalue_uses = 0;
+};
+
+struct forward_probe{
+    constexpr explicit forward_probe(probe_log* l): log(l){}
+    constexpr forward_probe(const forward_probe& other): log(other.log){++log->copies;}
+    constexpr forward_probe(forward_probe&& other): log(other.log){++log->moves;}
+
+    //The functions the examples in this file forward to are called foo and bar. These overloads are found by argument dependent lookup
+    //when a probe is passed to them, so they act as the end of the line and record which value category reached them.
+    friend constexpr void foo(forward_probe& p){++p.log->lvalue_uses;}
+    friend constexpr void foo(forward_probe&& p){++p.log->rvalue_uses;}
+    friend constexpr void bar(forward_probe& p){++p.log->lvalue_uses;}
+    friend constexpr void bar(forward_probe&& p){++p.log->rvalue_uses;}
+
+    probe_log* log;
+};
+
+//The probe records what happens to it in a log owned by the caller. An rvalue can end up in two places:
+//it can be moved into a new object (like a local variable or a member), or it can reach foo or bar as an rvalue reference without being moved at all.
+//If a function takes an rvalue and forwards it correctly, exactly one of those should happen, exactly once, and the probe should never be copied.
+//If the argument is never forwarded, it will be copied or passed on as an lvalue instead. If it's forwarded twice, it will be used as an rvalue twice.
+//If a function takes an lvalue, the probe should never be moved or passed on as an rvalue, because the caller still expects to be able to use it.
+
+template<typename F>
+constexpr bool forwards_rvalues(F f){
+    probe_log log;
+    f(forward_probe{&log});
+    return log.copies == 0 && log.moves + log.rvalue_uses == 1;
+}
+
+template<typename F>
+constexpr bool preserves_lvalues(F f){
+    probe_log log;
+    forward_probe p{&log};
+    f(p);
+    return log.moves == 0 && log.rvalue_uses == 0;
+}
+
+#define CHECK_FORWARDING(func) \
+    static_assert(forwards_rvalues([](auto&& x){func(std::forward<decltype(x)>(x));}), #func " doesn't forward an rvalue exactly once"); \
+    static_assert(preserves_lvalues([](auto&& x){func(std::forward<decltype(x)>(x));}), #func " moves from an lvalue")
+
+//The lambda in the macro is just there so that the function template can be passed around without choosing its template arguments.
+//Lambdas are implicitly constexpr if they can be, so as long as the function being checked is constexpr the whole thing is evaluated by the compiler.
+//For example:
+
+template<typename T>
+constexpr void goodStore(T&& val){[[maybe_unused]] std::decay_t<T> stored = std::forward<T>(val);}
+
+template<typename T>
+constexpr void copyingStore(T&& val){std::decay_t<T> stored = val;}
+
+template<typename T>
+constexpr void doubleStore(T&& val){
+    std::decay_t<T> stored1 = std::forward<T>(val);
+    std::decay_t<T> stored2 = std::forward<T>(val);
+}
+
+CHECK_FORWARDING(goodStore);
+CHECK_FORWARDING(exampleFunc3); //passes the probe straight to bar, without moving it
+//CHECK_FORWARDING(copyingStore); //<- build error: copyingStore doesn't forward an rvalue exactly once
+//CHECK_FORWARDING(doubleStore); //<- build error: doubleStore doesn't forward an rvalue exactly once
+
+//If you tried to check a function with a parameter that isn't a forwarding reference, like exampleFunc2's const T&&,
+//it would also fail to build, since the lvalue probe can't bind to it.
+//Since the checks are static_asserts, they're run every time the file is compiled.
+
+
+
+//--------------------------------------------------
+//FORWARDING INTO ANOTHER THREAD
+//--------------------------------------------------
+
+//Forwarding works a bit differently when the function is going to be called on another thread.
+//In the deferred calls section, lvalues were stored as references because the caller was expected to keep them alive.
+//When a function is handed off to another thread, the caller usually moves on right away, so references are too dangerous to keep.
+//Instead, everything is stored by value: lvalues are copied into the task and rvalues are moved into it.
+//This is what std::thread and std::async do, and it's why you need to wrap an argument in std::ref if you really want a reference.
+//The type you get by stripping the reference and cv-qualifiers off of a deduced forwarding reference is std::decay_t<Ts>,
+//so a std::tuple<std::decay_t<Ts>...> constructed from std::forward<Ts>(vals)... copies or moves each argument exactly once.
+//Then when the task runs, the tuple is moved into std::apply, so each argument is moved into the function exactly once more.
+
+//Below is a small thread pool that runs tasks this way:
+
+class thread_pool{
+public:
+
+    explicit thread_pool(size_t count = std::thread::hardware_concurrency()){
+        if(count == 0){count = 1;}
+        for(size_t i = 0; i < count; ++i){workers.emplace_back([this]{run();});}
+    }
+
+    ~thread_pool(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for(std::thread& worker : workers){worker.join();}
+    }
+
+    template<typename F, typename ...Ts>
+    std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Ts>...>> submit(F&& f, Ts&&... vals){
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Ts>...>;
+        
+        auto state = std::make_shared<task_state<R, std::decay_t<F>, std::decay_t<Ts>...>>(std::forward<F>(f), std::forward<Ts>(vals)...);
+        std::future<R> result = state->task.get_future();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.emplace([state]{state->task();});
+        }
+        ready.notify_one();
+        return result;
+    }
+
+private:
+
+    //Holds the function and its arguments in the same place for the whole life of the task, so they're never moved around after they're stored.
+    //The packaged_task only holds a pointer back to them, which is safe because the state is never moved once make_shared creates it.
+    template<typename R, typename F, typename ...Ts>
+    struct task_state{
+        template<typename G, typename ...Us>
+        task_state(G&& g, Us&&... vals):
+            func(std::forward<G>(g)), args(std::forward<Us>(vals)...),
+            task([this]{return std::apply(std::move(func), std::move(args));}){}
+
+        F func;
+        std::tuple<Ts...> args;
+        std::packaged_task<R()> task;
+    };
+
+    void run(){
+        while(true){
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this]{return stopping || !jobs.empty();});
+                if(jobs.empty()){return;}
+                job = std::move(jobs.front());
+                jobs.pop();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping = false;
+};
+
+//The std::packaged_task is held by a std::shared_ptr because std::function has to be copyable, but std::packaged_task can only be moved.
+//If the arguments were captured in a lambda that was given to the std::packaged_task instead, that lambda (and every argument in it)
+//would be moved again when the std::packaged_task takes it, which is why the function and arguments live next to the task in task_state.
+//Calling submit gives you back a std::future, and calling get() on the future waits for the task to finish and returns the result.
+//If you wrote this:
+//    thread_pool pool;
+//    std::string s = "hello";
+//    auto f = pool.submit([](std::string x, std::string y){return x + y;}, s, std::string(" world"));
+//Then s is copied into the task, the temporary std::string is moved into it, and f.get() returns "hello world".
+//Since the pool's destructor finishes the remaining jobs before joining the threads, every future it handed out will eventually be ready.
+
+
+
+//--------------------------------------------------
+//GROUPING ARGUMENTS BY VALUE CATEGORY
+//--------------------------------------------------
+
+//Since the value category of each argument is part of its deduced type, you can also make decisions about the arguments
+//at compile time based on whether they're lvalues or rvalues.
+//For example, exampleFunc4 calls foo in the same order as its arguments, so the lvalue and rvalue overloads are interleaved.
+//If you'd rather call the lvalue overload on all the lvalues first, then the rvalue overload on all the rvalues, you can do this:
+
+template<bool Lvalues, typename Tuple, size_t ...Is>
+void fooWhere(Tuple& args, std::index_sequence<Is...>){
+    ([&]{
+        using Arg = std::tuple_element_t<Is, Tuple>;
+        if constexpr(std::is_lvalue_reference_v<Arg> == Lvalues){foo(std::forward<Arg>(std::get<Is>(args)));}
+    }(), ...);
+}
+
+template<typename ...Ts>
+void exampleFunc5(Ts&&... vals){
+    auto args = std::forward_as_tuple(std::forward<Ts>(vals)...);
+    fooWhere<true>(args, std::index_sequence_for<Ts...>{});
+    fooWhere<false>(args, std::index_sequence_for<Ts...>{});
+}
+
+//std::forward_as_tuple creates a std::tuple<Ts&&...>, which means that the lvalues are stored as lvalue references and
+//the rvalues as rvalue references, so nothing is copied or moved when the tuple is created.
+//std::index_sequence_for<Ts...> is a std::index_sequence<0, 1, ..., N-1> where N is sizeof...(Ts), so Is is a pack of the index of every argument.
+//fooWhere expands Is into a comma fold of lambdas that are called immediately. Each lambda uses if constexpr to check
+//the category of its argument, so the calls to foo that don't match are never compiled at all.
+//Since the elements of the tuple are named variables, std::get always returns an lvalue, so std::forward is used to turn the
+//rvalue references back into rvalues.
+//If you called it like
+//    exampleFunc5(5, a, 5, a, 5);
+//It would call the lvalue foo twice, then the rvalue foo three times.
+//Keep in mind that this changes the order that the arguments are used in, so you should only do it when the calls don't depend on each other.
+
+
+
+//--------------------------------------------------
+//MOVE-ONLY PIPELINES
+//--------------------------------------------------
+
+//Unlike a forwarding reference, a function parameter like unique_buffer&& (where the type isn't a deduced template parameter)
+//is always a plain rvalue reference. You can use this to make a function that will only accept something that the caller is giving up.
+//Combine that with a type that can't be copied, and you can pass large objects through a chain of functions
+//with a guarantee that the compiler never copies them: if any step tried to, the code wouldn't build.
+
+class unique_buffer{
+public:
+
+    unique_buffer() = default;
+    explicit unique_buffer(size_t size): bytes(new unsigned char[size]), length(size){}
+
+    unique_buffer(const unique_buffer&) = delete;
+    unique_buffer& operator=(const unique_buffer&) = delete;
+    unique_buffer(unique_buffer&& other) noexcept: bytes(std::move(other.bytes)), length(std::exchange(other.length, 0)){}
+    unique_buffer& operator=(unique_buffer&& other) noexcept{
+        bytes = std::move(other.bytes);
+        length = std::exchange(other.length, 0);
+        return *this;
+    }
+
+    unsigned char* begin(){return bytes.get();}
+    unsigned char* end(){return bytes.get() + length;}
+    size_t size() const {return length;}
+
+private:
+    std::unique_ptr<unsigned char[]> bytes;
+    size_t length = 0;
+};
+
+//Allocating a new buffer for every chunk of data is wasteful, so the buffers that reach the end of a pipeline are given back to a pool
+//and handed out again instead of being freed.
+
+class buffer_pool{
+public:
+
+    unique_buffer acquire(size_t size){
+        for(auto it = spare.begin(); it != spare.end(); ++it){
+            if(it->size() == size){
+                unique_buffer buffer = std::move(*it);
+                spare.erase(it);
+                return buffer;
+            }
+        }
+        return unique_buffer(size);
+    }
+
+    void release(unique_buffer&& buffer){spare.push_back(std::move(buffer));}
+
+private:
+    std::vector<unique_buffer> spare;
+};
+
+//A stage of the pipeline is any function that takes a unique_buffer&& and gives back a unique_buffer.
+//The operator| below lets you write the stages in the order they happen, like buffer | stage1 | stage2 | pool.
+
+template<typename F>
+struct stage{F func;};
+
+template<typename F>
+stage<std::decay_t<F>> make_stage(F&& f){return {std::forward<F>(f)};}
+
+template<typename F>
+unique_buffer operator|(unique_buffer&& buffer, stage<F>& s){
+    static_assert(std::is_same_v<std::invoke_result_t<F&, unique_buffer&&>, unique_buffer>,
+                  "a stage must take ownership of the buffer and give it back by value");
+    return s.func(std::move(buffer));
+}
+
+inline void operator|(unique_buffer&& buffer, buffer_pool& pool){pool.release(std::move(buffer));}
+
+//Since the first parameter of both operators is an rvalue reference, you can't accidentally pipe a buffer that you still plan to use:
+//    unique_buffer b = pool.acquire(1024);
+//    b | pool; //<- build error, b is an lvalue
+//    std::move(b) | pool; //<- fine, and b is now empty
+//The static_assert catches stages that return a reference (which would leave ownership somewhere else) or take the buffer by const&
+//and try to return a copy of it. A stage that takes the buffer by value is fine, since it's just moved into the parameter.
+//The operators take the stage by lvalue reference so that the same stage can be reused for every buffer, like this:
+//    auto invert = make_stage([](unique_buffer&& b){for(unsigned char& c : b){c = ~c;} return std::move(b);});
+//    for(size_t i = 0; i < chunks; ++i){pool.acquire(1 << 20) | invert | pool;}
+//After the first chunk, every acquire gets back the buffer that the previous chunk released, so the loop only allocates once.
+
+
+
+//--------------------------------------------------
+//WHEN NOT TO FORWARD
+//--------------------------------------------------
+
+//std::forward should be used at most once per argument, at the point where the argument is actually handed off.
+//If a function uses an argument more than once, forwarding it on every use would move from it the first time,
+//leaving a moved-from object for every use after that.
+//A function that times another function is a good example of this, since it calls the same function with the same arguments over and over:
+
+struct timing_stats{
+    double median_ns;
+    double p99_ns;
+    double mad_ns; //median absolute deviation: the median distance of a sample from the median
+    size_t samples;
+    double median_cycles; //0 if the processor's cycle counter isn't available
+};
+
+//Two things make timings much less noisy. The first is keeping the thread on one core: if the operating system moves it
+//to another core partway through, the caches are cold again. cpu_pin restricts the thread to one core for as long as it exists,
+//then puts back whatever cores it was allowed to use before. It's only implemented on Linux, and does nothing elsewhere.
+
+class cpu_pin{
+public:
+
+    explicit cpu_pin(int cpu){
+#if defined(__linux__)
+        if(::sched_getaffinity(0, sizeof(previous), &previous) != 0){return;}
+        cpu_set_t only;
+        CPU_ZERO(&only);
+        CPU_SET(cpu, &only);
+        active = ::sched_setaffinity(0, sizeof(only), &only) == 0;
+#else
+        (void)cpu;
+#endif
+    }
+
+    cpu_pin(const cpu_pin&) = delete;
+    cpu_pin& operator=(const cpu_pin&) = delete;
+
+    ~cpu_pin(){
+#if defined(__linux__)
+        if(active){::sched_setaffinity(0, sizeof(previous), &previous);}
+#endif
+    }
+
+    bool pinned() const {return active;}
+
+private:
+#if defined(__linux__)
+    cpu_set_t previous;
+#endif
+    bool active = false;
+};
+
+//The second is using a finer clock. On x86-64, the rdtsc instruction reads a counter that goes up at a constant rate (close to the
+//processor's base frequency), and reading it takes far less time than calling steady_clock::now(). It's reported next to the nanoseconds,
+//which still come from steady_clock (clock_gettime on Linux), since the rate of the counter isn't the same on every machine.
+
+inline unsigned long long readCycles(){
+#if defined(__x86_64__) && defined(__GNUC__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//The median of a sorted list. With an even number of samples, there are two middle samples, so it's their average.
+inline double sortedMedian(const std::vector<double>& sorted){
+    size_t n = sorted.size();
+    return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+template<typename T>
+void keepResult(T& result){
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&result) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &result;
+#endif
+}
+
+template<typename F, typename ...Ts>
+timing_stats measure(size_t warmup, size_t samples, F&& f, Ts&&... vals){
+    auto run = [&]{
+        if constexpr(std::is_void_v<std::invoke_result_t<F&, Ts&...>>){std::invoke(f, vals...);}
+        else{
+            auto result = std::invoke(f, vals...);
+            keepResult(result);
+        }
+    };
+    
+    if(samples == 0){return {0, 0, 0, 0, 0};} //nothing to measure
+    
+    for(size_t i = 0; i < warmup; ++i){run();}
+    
+    std::vector<double> times(samples);
+    std::vector<double> cycles(samples);
+    for(size_t i = 0; i < samples; ++i){
+        auto start = std::chrono::steady_clock::now();
+        unsigned long long start_cycles = readCycles();
+        run();
+        cycles[i] = static_cast<double>(readCycles() - start_cycles);
+        times[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    std::sort(times.begin(), times.end());
+    std::sort(cycles.begin(), cycles.end());
+    double median = sortedMedian(times);
+    double p99 = times[(samples * 99 + 99) / 100 - 1]; //the nearest rank: the smallest sample that at least 99% of the samples are less than or equal to
+    for(double& time : times){time = std::abs(time - median);}
+    std::sort(times.begin(), times.end());
+    return {median, p99, sortedMedian(times), samples, sortedMedian(cycles)};
+}
+
+//Even though measure takes forwarding references, f and vals are deliberately never forwarded.
+//They're passed to std::invoke as lvalues every time, so an rvalue argument is only ever moved once: into the parameter of whatever f takes by value.
+//(This is also exactly what CHECK_FORWARDING would complain about, since the probe would be copied on every call.)
+
+//keepResult stops the compiler from noticing that the result is never used and removing the call entirely.
+//The empty asm statement tells the compiler that something it can't see might read the result, so it has to actually compute it.
+//Other compilers get a store to a volatile pointer instead. The volatile has to go after the *, since it's the pointer itself
+//that has to be written, not the data it points to.
+
+//The warmup calls let the caches and branch predictors settle before measuring. The median and the median absolute deviation are used
+//instead of the mean and standard deviation because a few very slow samples (like when the thread gets interrupted) don't affect them much.
+//If you want to keep track of the results over time, it's easiest to print them in a format that another program can read, like JSON:
+
+inline void reportJson(std::ostream& out, const std::string& name, const timing_stats& stats){
+    out << "{\"name\": \"" << name << "\", \"median_ns\": " << stats.median_ns << ", \"p99_ns\": " << stats.p99_ns
+        << ", \"mad_ns\": " << stats.mad_ns << ", \"median_cycles\": " << stats.median_cycles << ", \"samples\": " << stats.samples << "}\n";
+}
+
+//steady_clock is usually precise to a few tens of nanoseconds, so for anything shorter than that you should time a loop of calls instead of a single one.
+
+//To run a whole set of benchmarks the same way every time, they can be collected in a suite. add stores the function and its arguments
+//(copying lvalues and moving rvalues, like the thread pool does), and run pins the thread to one core and reports every benchmark as a line of JSON.
+//This is the one place where the arguments are forwarded: into the stored copy. After that, measure uses them as lvalues like before.
+
+class benchmark_suite{
+public:
+
+    template<typename F, typename ...Ts>
+    void add(std::string name, F&& f, Ts&&... vals){
+        benchmarks.push_back({std::move(name),
+            [func = std::decay_t<F>(std::forward<F>(f)), args = std::tuple<std::decay_t<Ts>...>(std::forward<Ts>(vals)...)]
+            (size_t warmup, size_t samples) mutable {
+                return std::apply([&](auto&... a){return measure(warmup, samples, func, a...);}, args);
+            }});
+    }
+
+    void run(std::ostream& out, size_t warmup = 10, size_t samples = 100, int cpu = 0){
+        cpu_pin pin(cpu);
+        for(benchmark& b : benchmarks){reportJson(out, b.name, b.run(warmup, samples));}
+    }
+
+private:
+
+    struct benchmark{
+        std::string name;
+        std::function<timing_stats(size_t, size_t)> run;
+    };
+
+    std::vector<benchmark> benchmarks;
+};
+
+//The medians come from sortedMedian, so with an even number of samples they're the average of the two in the middle.
+//The cycle counts are only comparable between runs on the same machine, but since they don't depend on how long reading
+//the clock takes, they're better than the nanoseconds for telling apart two versions of something that only takes a few hundred cycles.
+
+
+
 int main(){
     
     exampleFunc1(a);
     
     exampleFunc4(5, a, 5, a, 5);
     
+    exampleFunc5(5, a, 5, a, 5); //The lvalues are passed to foo first, then the rvalues
+    
     std::vector<std::string> v1;
     v1.emplace_back(5, 'h'); //Uses std::string(5,'h') to construct a new std::string at the end of the vector.
     
+    auto d1 = defer([](int& x, int&& y){return x + y;}, a, 5); //Nothing is called yet
+    std::cout << d1() << ' ' << d1() << std::endl; //The lambda is only called the first time
+    
+    thread_pool pool(2);
+    std::string s1 = "hello";
+    auto f1 = pool.submit([](std::string x, std::string y){return x + y;}, s1, std::string(" world")); //s1 is copied, the temporary is moved
+    std::cout << f1.get() << std::endl;
+    
+    buffer_pool buffers;
+    auto invert = make_stage([](unique_buffer&& b){for(unsigned char& c : b){c = ~c;} return std::move(b);});
+    for(int i = 0; i < 4; ++i){buffers.acquire(1 << 20) | invert | buffers;} //The same 1 MB buffer is reused every time
+    
+    benchmark_suite suite;
+    suite.add("invert 1 MB", [&]{buffers.acquire(1 << 20) | invert | buffers;});
+    suite.add("pool round trip", [&](const std::string& x){return pool.submit([](std::string y){return y.size();}, x).get();}, s1);
+    suite.add("deferred call", [](int x){auto d = defer([](int y){return y * 2;}, std::move(x)); return d();}, 21);
+    suite.run(std::cout);
+    
     
     return 0;
 }
@@ -2,6 +2,28 @@
 #include <iostream>
 #include <array>
 #include <vector>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <ios>
+#include <complex>
+#include <cstdint>
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //Function templates as member functions
 
@@ -124,6 +146,476 @@ constexpr T pi = T(3.1415926535897932385L);
 
 
 
+//--------------------------------------------------
+//COMPILE TIME SWITCHES
+//--------------------------------------------------
+
+//Since a constexpr variable template can be specialized like any other template, it works well as a set of compile time settings.
+//For example, suppose you want to be able to turn on tracing (recording when certain functions start and stop) for some parts of a program.
+//The default can come from a macro so that a build can turn it on for everything with a compiler flag like -DTEMPLATE_GUIDE_TRACING=1,
+//and individual parts of the program can be turned on or off by specializing the variable template for a tag type.
+
+#ifndef TEMPLATE_GUIDE_TRACING
+#define TEMPLATE_GUIDE_TRACING 0
+#endif
+
+template<typename Module>
+constexpr bool tracing_enabled = TEMPLATE_GUIDE_TRACING;
+
+struct sorting_module;
+
+//    template<>
+//    constexpr bool tracing_enabled<sorting_module> = true; //<- would turn tracing on just for sorting
+
+//The setting picks which version of the trace class template is used. When it's off, the scope type is empty
+//and its constructor does nothing, so the compiler removes it entirely: there's no cost to leaving it in the code.
+
+template<bool Enabled>
+struct trace{
+    struct scope{
+        explicit constexpr scope(const char*){}
+    };
+    static void dump(std::ostream&){}
+};
+
+//When it's on, each scope remembers when it was created, and when it's destroyed it adds an event to a buffer for the current thread.
+//Each thread only ever writes to its own buffer, so recording an event never needs a lock.
+//The buffers are owned by a shared list, so they're still around to be dumped after their threads have finished.
+
+template<>
+struct trace<true>{
+
+    struct event{
+        const char* name;
+        double start_us;
+        double duration_us;
+    };
+
+    struct thread_buffer{
+        std::array<event, 4096> events;
+        std::atomic<size_t> count{0};
+        size_t thread_id = 0;
+    };
+
+    static double now_us(){
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static thread_buffer& local(){
+        thread_local thread_buffer* buffer = []{
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            buffers.push_back(std::make_unique<thread_buffer>());
+            buffers.back()->thread_id = buffers.size();
+            return buffers.back().get();
+        }();
+        return *buffer;
+    }
+
+    struct scope{
+        explicit scope(const char* n): name(n), start(now_us()){}
+        ~scope(){
+            thread_buffer& buffer = local();
+            size_t index = buffer.count.load(std::memory_order_relaxed);
+            if(index < buffer.events.size()){
+                buffer.events[index] = {name, start, now_us() - start};
+                buffer.count.store(index + 1, std::memory_order_release);
+            }
+        }
+        const char* name;
+        double start;
+    };
+
+    //Writes every recorded event in the Chrome trace format, which can be opened in chrome://tracing or ui.perfetto.dev.
+    static void dump(std::ostream& out){
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        std::ios_base::fmtflags flags = out.flags(std::ios_base::fixed);
+        out << "{\"traceEvents\": [";
+        const char* separator = "";
+        for(const auto& buffer : buffers){
+            size_t count = buffer->count.load(std::memory_order_acquire);
+            for(size_t i = 0; i < count; ++i){
+                const event& e = buffer->events[i];
+                out << separator << "{\"name\": \"" << e.name << "\", \"ph\": \"X\", \"ts\": " << e.start_us
+                    << ", \"dur\": " << e.duration_us << ", \"pid\": 0, \"tid\": " << buffer->thread_id << "}";
+                separator = ", ";
+            }
+        }
+        out << "]}\n";
+        out.flags(flags);
+    }
+
+    inline static std::mutex registry_mutex;
+    inline static std::vector<std::unique_ptr<thread_buffer>> buffers;
+};
+
+template<typename Module>
+using tracer = trace<tracing_enabled<Module>>;
+
+//The count is atomic so that dump can safely run while other threads are still recording: the release store makes sure an event
+//is completely written before dump can see it. The lock is only taken the first time a thread records something, and when dumping.
+//If a thread records more than 4096 events, the rest are dropped instead of allocating more memory in the middle of the traced code.
+//Inside a function you'd write
+//    tracer<sorting_module>::scope trace_scope("networkSort");
+//and it turns into either nothing, or a timestamped event, depending on tracing_enabled<sorting_module>.
+//Note that trace<true> is an explicit specialization, so its static members are defined with inline (added in C++17) instead of outside the class.
+
+
+
+//--------------------------------------------------
+//SORTING NETWORKS
+//--------------------------------------------------
+
+//Variable templates are a convenient way to store a table that's computed at compile time for each value of a template parameter.
+//A good example of this is a sorting network. A sorting network is a fixed list of compare-exchange operations
+//(compare two positions, and swap them if they're out of order) that sorts any input of a certain size.
+//Since the list doesn't depend on the values being sorted, there are no branches that depend on the data,
+//which makes it much faster than a general sorting algorithm like std::sort for small arrays.
+
+//The network below is Batcher's odd-even merge sort. It isn't the smallest possible network for every size,
+//but it works for any size and is easy to generate. First, a constexpr function that runs the algorithm without doing anything,
+//just to count how many compare-exchanges it needs. The size of a std::array has to be known at compile time, so we need this first.
+
+template<typename F>
+constexpr void forEachComparator(size_t n, F f){
+    for(size_t p = 1; p < n; p *= 2){
+        for(size_t k = p; k >= 1; k /= 2){
+            for(size_t j = k % p; j + k < n; j += 2 * k){
+                for(size_t i = 0; i < k && i + j + k < n; ++i){
+                    if((i + j) / (2 * p) == (i + j + k) / (2 * p)){f(i + j, i + j + k);}
+                }
+            }
+        }
+    }
+}
+
+constexpr size_t comparatorCount(size_t n){
+    size_t count = 0;
+    forEachComparator(n, [&count](size_t, size_t){++count;});
+    return count;
+}
+
+struct comparator{
+    size_t low;
+    size_t high;
+};
+
+template<size_t N>
+constexpr std::array<comparator, comparatorCount(N)> sort_network = []{
+    std::array<comparator, comparatorCount(N)> network{};
+    size_t index = 0;
+    forEachComparator(N, [&](size_t low, size_t high){network[index++] = {low, high};});
+    return network;
+}();
+
+//sort_network<8> is an array of 19 comparators, and sort_network<16> is an array of 63. Each one is only computed once, by the compiler.
+//To use the network, every comparator is expanded into its own compare-exchange with std::index_sequence,
+//so the whole sort is unrolled into straight line code:
+
+template<size_t N, size_t ...Is>
+void applyNetwork(std::array<int, N>& values, std::index_sequence<Is...>){
+    ((void)[&]{
+        constexpr comparator c = sort_network<N>[Is];
+        int low = values[c.low], high = values[c.high];
+        values[c.low] = std::min(low, high);
+        values[c.high] = std::max(low, high);
+    }(), ...);
+}
+
+template<size_t N>
+void networkSort(std::array<int, N>& values){
+    static_assert(N <= 32, "networks larger than this generate too much code to be worth it");
+    tracer<sorting_module>::scope trace_scope("networkSort");
+    applyNetwork(values, std::make_index_sequence<comparatorCount(N)>{});
+}
+
+//std::min and std::max on ints compile to conditional moves (or min/max instructions) instead of branches,
+//so the time it takes doesn't depend on the order of the input.
+//If you sort many arrays of the same size at once, the compiler can also vectorize these operations across the arrays,
+//since every array goes through exactly the same sequence of steps.
+
+
+
+//--------------------------------------------------
+//RECURSIVE TEMPLATES: THE FFT
+//--------------------------------------------------
+
+//Non-type parameters can also drive recursion at compile time. A class template can use itself with a different argument,
+//and a specialization stops the recursion, the same way a base case does in a recursive function.
+//The fast Fourier transform (FFT) is a good fit for this. An FFT of size N is computed from two FFTs of size N/2
+//(one of the even elements and one of the odd elements), which are combined using the "twiddle factors" e^(-2*pi*i*k/N).
+//If N is a template parameter, every level of the recursion is a separate function whose size is a constant,
+//so the compiler can inline all of them and unroll their loops.
+
+//The twiddle factors only depend on N, so they can be computed at compile time and stored in a variable template.
+//std::sin and std::cos aren't constexpr, so here are constexpr versions using their Taylor series.
+//The series are only accurate for small angles: near +-pi the terms are large and mostly cancel each other out,
+//which loses precision in exactly the values that should be close to 0. So the angle is first written as q * pi/2 + r,
+//with r between -pi/4 and pi/4, and the symmetries of sin and cos (sin(x + pi/2) = cos(x), and so on) pick which series to use on r.
+//pi/2 isn't exactly representable, so it's split into a high part and a low part (half_pi_hi + half_pi_lo is pi/2 to about twice the precision of T),
+//and r is computed as x - q * half_pi_hi - q * half_pi_lo. The first subtraction is exact when x is close to q * pi/2,
+//so r keeps almost all of its precision even when it's tiny. This is called Cody-Waite reduction.
+
+template<typename T>
+constexpr T half_pi_hi = static_cast<T>(1.5707963267948966); //the double closest to pi/2
+
+template<typename T>
+constexpr T half_pi_lo = static_cast<T>((1.5707963267948966 - static_cast<double>(half_pi_hi<T>)) + 6.123233995736766e-17);
+
+template<typename T>
+constexpr T sinSeries(T x){
+    T term = x, sum = x;
+    for(int n = 1; n < 12; ++n){
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+template<typename T>
+constexpr T cosSeries(T x){
+    T term = 1, sum = 1;
+    for(int n = 1; n < 12; ++n){
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+//Returns sin(x) if Cos is false, and cos(x) if it's true. Since cos(x) = sin(x + pi/2), cos just starts one quarter turn further along.
+template<bool Cos, typename T>
+constexpr T sinOrCos(T x){
+    T quarters = x / half_pi_hi<T>;
+    long long q = static_cast<long long>(quarters < 0 ? quarters - T(0.5) : quarters + T(0.5));
+    T r = (x - static_cast<T>(q) * half_pi_hi<T>) - static_cast<T>(q) * half_pi_lo<T>;
+    switch(((q % 4) + 4 + (Cos ? 1 : 0)) % 4){
+        case 0: return sinSeries(r);
+        case 1: return cosSeries(r);
+        case 2: return -sinSeries(r);
+        default: return -cosSeries(r);
+    }
+}
+
+template<typename T>
+constexpr T constexprSin(T x){return sinOrCos<false>(x);}
+
+template<typename T>
+constexpr T constexprCos(T x){return sinOrCos<true>(x);}
+
+//With r at most pi/4, 12 terms of each series are enough for double precision, and the twiddle factors come out within a few ulps
+//of std::sin and std::cos. q * half_pi_hi is only exact while q is small, so the functions get less accurate for very large angles,
+//but the angles used below are never bigger than pi.
+
+template<typename T, size_t N>
+struct twiddle_table{
+    std::array<T, N / 2> re;
+    std::array<T, N / 2> im;
+};
+
+template<typename T, size_t N>
+constexpr twiddle_table<T, N> twiddles = []{
+    twiddle_table<T, N> table{};
+    for(size_t k = 0; k < N / 2; ++k){
+        table.re[k] = constexprCos(-2 * pi<T> * static_cast<T>(k) / static_cast<T>(N));
+        table.im[k] = constexprSin(-2 * pi<T> * static_cast<T>(k) / static_cast<T>(N));
+    }
+    return table;
+}();
+
+//fft_impl<T, N>::run reads N elements from in (each stride elements apart) and writes the transform to out.
+//The even elements are every 2*stride elements starting at in, and the odd ones start at in + stride, so the
+//recursion never has to copy the input into separate arrays.
+
+template<typename T, size_t N>
+struct fft_impl{
+    static void run(const std::complex<T>* in, std::complex<T>* out, size_t stride){
+        fft_impl<T, N / 2>::run(in, out, stride * 2);
+        fft_impl<T, N / 2>::run(in + stride, out + N / 2, stride * 2);
+        constexpr const twiddle_table<T, N>& w = twiddles<T, N>;
+        for(size_t k = 0; k < N / 2; ++k){
+            T odd_re = out[k + N / 2].real(), odd_im = out[k + N / 2].imag();
+            T t_re = w.re[k] * odd_re - w.im[k] * odd_im;
+            T t_im = w.re[k] * odd_im + w.im[k] * odd_re;
+            std::complex<T> even = out[k];
+            out[k] = {even.real() + t_re, even.imag() + t_im};
+            out[k + N / 2] = {even.real() - t_re, even.imag() - t_im};
+        }
+    }
+};
+
+template<typename T>
+struct fft_impl<T, 1>{
+    static void run(const std::complex<T>* in, std::complex<T>* out, size_t){out[0] = in[0];}
+};
+
+template<typename T, size_t N>
+std::array<std::complex<T>, N> fft(const std::array<std::complex<T>, N>& in){
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the size of the FFT must be a power of two");
+    std::array<std::complex<T>, N> out;
+    fft_impl<T, N>::run(in.data(), out.data(), 1);
+    return out;
+}
+
+//The partial specialization fft_impl<T, 1> is the base case: the FFT of a single element is just that element.
+//fft<double, 256> instantiates fft_impl for 256, 128, 64, ..., 2, and 1, and nothing else.
+//The complex multiplication is written out by hand instead of using std::complex's operator*.
+//That's because the standard operator* has to handle infinities and NaNs specially, which (without flags like -ffast-math)
+//usually turns into a call to a library function and stops the compiler from vectorizing the loop.
+//Written out like this, the loop is just multiplies and adds, which the compiler can turn into SIMD instructions.
+
+
+
+//--------------------------------------------------
+//FILE BACKED VECTORS
+//--------------------------------------------------
+
+//vec<T> is just another name for std::vector<T>, which keeps its elements in memory on the heap.
+//If the data is bigger than the available memory, or you want it to still be there the next time the program runs,
+//you need to keep it in a file instead. On Linux, mmap lets you treat a file as though it were memory:
+//reading from the mapped memory reads the file, and writing to it writes the file, with the operating system
+//loading and saving pieces of the file as they're used.
+//This only works for types that can be copied byte for byte (trivially copyable types), since the objects are never constructed
+//or destroyed, they're just bytes in a file. The class template enforces this with a static_assert.
+
+#if defined(__linux__)
+
+enum class access_pattern{normal, sequential, random};
+
+template<typename T>
+class mmap_vec{
+public:
+
+    static_assert(std::is_trivially_copyable_v<T>, "mmap_vec can only hold types that can be copied byte for byte");
+    static_assert(alignof(T) <= 64, "elements are stored 64 bytes into the file");
+
+    //Opens the file, creating it if it doesn't exist. If it was created by a previous mmap_vec, the elements are still there.
+    //Throws std::runtime_error if the file isn't empty but wasn't written by an mmap_vec of the same element size, or has been cut short.
+    explicit mmap_vec(const char* path){
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if(fd < 0){throw std::system_error(errno, std::generic_category(), "mmap_vec: open");}
+        struct stat info{};
+        if(::fstat(fd, &info) < 0){fail("fstat");}
+        size_t file_size = static_cast<size_t>(info.st_size);
+        if(file_size != 0 && file_size < header_bytes){invalid("the file is too small to have a header");}
+        mapped = std::max(file_size, header_bytes);
+        if(file_size < mapped && ::ftruncate(fd, static_cast<off_t>(mapped)) < 0){fail("ftruncate");}
+        void* p = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED){fail("mmap");}
+        base = static_cast<unsigned char*>(p);
+        if(file_size == 0){
+            header() = {magic, sizeof(T), 0};
+        }else{
+            if(header().magic != magic){invalid("the file wasn't created by an mmap_vec");}
+            if(header().element_size != sizeof(T)){invalid("the file holds elements of a different size");}
+            if(header().size > capacity()){invalid("the file is shorter than its header says");}
+        }
+    }
+
+    mmap_vec(const mmap_vec&) = delete;
+    mmap_vec& operator=(const mmap_vec&) = delete;
+
+    //Moving hands the file and the mapping over to the new mmap_vec. The old one is left without a file: its size and capacity are 0
+    //and data() is nullptr, so it can be read (as an empty vector), destroyed, or assigned to, but push_back on it throws.
+    mmap_vec(mmap_vec&& other) noexcept: fd(other.fd), base(other.base), mapped(other.mapped){
+        other.fd = -1;
+        other.base = nullptr;
+        other.mapped = 0;
+    }
+
+    mmap_vec& operator=(mmap_vec&& other) noexcept{
+        std::swap(fd, other.fd);
+        std::swap(base, other.base);
+        std::swap(mapped, other.mapped);
+        return *this;
+    }
+
+    ~mmap_vec(){
+        if(base){::munmap(base, mapped);}
+        if(fd >= 0){::close(fd);}
+    }
+
+    T* data(){return base ? reinterpret_cast<T*>(base + header_bytes) : nullptr;}
+    const T* data() const {return base ? reinterpret_cast<const T*>(base + header_bytes) : nullptr;}
+    T* begin(){return data();}
+    const T* begin() const {return data();}
+    T* end(){return data() + size();}
+    const T* end() const {return data() + size();}
+    T& operator[](size_t i){return data()[i];}
+    const T& operator[](size_t i) const {return data()[i];}
+
+    size_t size() const {return base ? header().size : 0;}
+    size_t capacity() const {return base ? (mapped - header_bytes) / sizeof(T) : 0;}
+
+    void push_back(const T& val){
+        if(size() == capacity()){reserve(std::max<size_t>(capacity() * 2, 4096 / sizeof(T) + 1));}
+        data()[size()] = val;
+        ++header().size;
+    }
+
+    //Grows the file, then grows the mapping. mremap can move the mapping to a new address if it needs to,
+    //but it does so by rearranging page tables, not by copying the data.
+    void reserve(size_t count){
+        if(count <= capacity()){return;}
+        size_t bytes = header_bytes + count * sizeof(T);
+        if(::ftruncate(fd, static_cast<off_t>(bytes)) < 0){throw std::system_error(errno, std::generic_category(), "mmap_vec: ftruncate");}
+        void* p = ::mremap(base, mapped, bytes, MREMAP_MAYMOVE);
+        if(p == MAP_FAILED){throw std::system_error(errno, std::generic_category(), "mmap_vec: mremap");}
+        base = static_cast<unsigned char*>(p);
+        mapped = bytes;
+    }
+
+    //Tells the operating system how the elements are going to be read, so it can read ahead for sequential access
+    //or avoid wasting time reading ahead for random access.
+    void advise(access_pattern pattern){
+        int advice = pattern == access_pattern::sequential ? MADV_SEQUENTIAL : pattern == access_pattern::random ? MADV_RANDOM : MADV_NORMAL;
+        ::madvise(base, mapped, advice);
+    }
+
+private:
+
+    struct file_header{
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+    };
+
+    static constexpr uint64_t magic = 0x3163657670616d6dULL; //"mmapvec1" when read as little endian bytes
+
+    static constexpr size_t header_bytes = 64;
+
+    file_header& header(){return *reinterpret_cast<file_header*>(base);}
+    const file_header& header() const {return *reinterpret_cast<const file_header*>(base);}
+
+    [[noreturn]] void fail(const char* what){
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), std::string("mmap_vec: ") + what);
+    }
+
+    [[noreturn]] void invalid(const char* what){
+        if(base){::munmap(base, mapped);}
+        ::close(fd);
+        throw std::runtime_error(std::string("mmap_vec: ") + what);
+    }
+
+    int fd = -1;
+    unsigned char* base = nullptr;
+    size_t mapped = 0;
+};
+
+#endif
+
+//The number of elements is stored at the start of the file, so the next mmap_vec that opens the file knows how many there are.
+//The header also holds a magic number and the size of an element, so that opening some other file, or a file written with a different T,
+//throws an exception instead of reading garbage. The size is checked against the size of the file too, since if the file had been cut short,
+//reading the elements past its end would crash the program with SIGBUS instead of just giving wrong values.
+//Opening an existing file doesn't read anything: the data is only loaded from disk as it's used, so reattaching to a huge file is instant.
+//The capacity isn't stored anywhere, it's just however much of the file comes after the header.
+//Like std::vector, growing the vector can move the elements to a new address, so pointers into it aren't safe to keep across a push_back.
+//Since the elements are stored exactly as they are in memory, the file can only be read on machines with the same
+//sizeof(T), alignment, and byte order.
+
+
+
 int main(){
     
 //    This function call works because the second overload can't fit this.
@@ -4,7 +4,17 @@
 #include <stdio.h>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <chrono>
 
 
 
@@ -272,6 +282,495 @@ extern template void exampleFunc1(double, std::string);
 //gets rid of all of the downsides of doing that.
 //You should only use the extern keyword if you instantiate the template with same parameters in another file.
 
+//C++20 adds modules, which change this picture: a module is compiled once, and files that import it don't reparse its templates,
+//though instantiations can still be generated in each file that uses them. Since this guide covers C++17, modules aren't discussed here.
+//Until then, extern templates are the tool for keeping header-only templates from being compiled over and over again.
+
+
+//--------------------------------------------------
+//COMPILE TIME FORMAT STRINGS
+//--------------------------------------------------
+
+//As mentioned above, a non-type parameter can be a pointer, as long as it points to something in static memory.
+//This includes a constexpr array of characters, which means you can pass a string to a template as long as it's declared like this:
+
+static constexpr char greeting[] = "{} is {} years old\n";
+
+//You can't write exampleFunc8<"{} is {} years old\n">() directly, since a string literal doesn't have linkage (C++20 changes this).
+//But since greeting is constexpr, the template can read the characters it points to at compile time.
+//This lets you write a print function that parses the format string while compiling, instead of every time it's called.
+
+//Each "{}" in the format string is a placeholder that gets replaced by the next argument. First, some constexpr helpers to find them:
+
+constexpr size_t formatLength(const char* fmt){
+    size_t length = 0;
+    while(fmt[length] != '\0'){++length;}
+    return length;
+}
+
+constexpr size_t countPlaceholders(const char* fmt){
+    size_t count = 0;
+    for(size_t i = 0; fmt[i] != '\0'; ++i){
+        if(fmt[i] == '{' && fmt[i + 1] == '}'){++count; ++i;}
+    }
+    return count;
+}
+
+//The text between the placeholders is stored as a list of (start, length) pairs, computed by a variable template.
+//A format string with N placeholders always has N+1 pieces of text around them (some of which may be empty).
+
+struct format_piece{
+    size_t start;
+    size_t length;
+};
+
+template<const char* Fmt>
+constexpr std::array<format_piece, countPlaceholders(Fmt) + 1> format_pieces = []{
+    std::array<format_piece, countPlaceholders(Fmt) + 1> pieces{};
+    size_t piece = 0, start = 0, i = 0;
+    for(; Fmt[i] != '\0'; ++i){
+        if(Fmt[i] == '{' && Fmt[i + 1] == '}'){
+            pieces[piece++] = {start, i - start};
+            start = i + 2;
+            ++i;
+        }
+    }
+    pieces[piece] = {start, i - start};
+    return pieces;
+}();
+
+//Then, there's an overload for writing each kind of argument into a buffer:
+
+inline void formatArg(std::string& out, const std::string& val){out += val;}
+inline void formatArg(std::string& out, const char* val){out += val;}
+inline void formatArg(std::string& out, std::string_view val){out += val;}
+inline void formatArg(std::string& out, char val){out += val;}
+inline void formatArg(std::string& out, bool val){out += val ? "true" : "false";}
+
+//bool is an integral type, but std::to_chars has a deleted overload for bool, so it has to be kept out of the integer template
+//and handled by its own overload above.
+
+template<typename T>
+std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>> formatArg(std::string& out, T val){
+    char digits[24];
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), val).ptr);
+}
+
+inline void formatArg(std::string& out, double val){
+    char digits[32];
+    out.append(digits, std::snprintf(digits, sizeof(digits), "%g", val));
+}
+
+//Finally, the print function. The number of arguments is checked against the number of placeholders with a static_assert,
+//so passing the wrong number of arguments is a build error instead of a runtime error.
+//The arguments are written with a fold over the comma operator, using std::index_sequence to know which piece of text goes after each one.
+
+template<const char* Fmt, typename ...Args, size_t ...Is>
+void printPieces(std::string& out, std::index_sequence<Is...>, const Args&... args){
+    constexpr auto& pieces = format_pieces<Fmt>;
+    out.append(Fmt + pieces[0].start, pieces[0].length);
+    ((formatArg(out, args), out.append(Fmt + pieces[Is + 1].start, pieces[Is + 1].length)), ...);
+}
+
+template<const char* Fmt, typename ...Args>
+void print(const Args&... args){
+    static_assert(sizeof...(Args) == countPlaceholders(Fmt), "the number of arguments doesn't match the number of {} in the format string");
+    thread_local std::string buffer;
+    buffer.clear();
+    printPieces<Fmt>(buffer, std::index_sequence_for<Args...>{}, args...);
+    std::cout.write(buffer.data(), buffer.size());
+}
+
+//So if you call it like this:
+//    print<greeting>("Alice", 30);
+//It will print "Alice is 30 years old".
+//Every print<greeting> call shares the same format_pieces<greeting>, which the compiler computed ahead of time,
+//so at runtime all it does is append the pieces of text and the arguments in order.
+//The buffer is thread_local and only ever cleared (which keeps its capacity), so after the first few calls it doesn't need to allocate anymore.
+//This version doesn't support escaping braces or format options like {:x}, but those could be handled in the same way by
+//storing more information in each format_piece.
+
+
+
+//--------------------------------------------------
+//NON-TYPE PARAMETERS AS SIZES
+//--------------------------------------------------
+
+//The most common use of non-type parameters is giving a class template a size that's known at compile time, like std::array<T, N>.
+//Besides letting the class store its elements directly instead of on the heap, knowing the size at compile time lets you
+//check it with static_assert and lets the compiler optimize arithmetic involving it.
+//For example, here is a ring buffer (a fixed size queue that wraps around to the start of its array) that passes values from one thread to another.
+//When the capacity is a power of two, "index % N" is the same as "index & (N - 1)", which is much faster than a division.
+//Since N is a template parameter, N - 1 is a constant, and the static_assert makes sure that this trick is always valid.
+
+template<typename T, size_t N>
+class spsc_ring{
+public:
+
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the capacity must be a power of two");
+
+    bool push(const T& val){return push_batch(&val, 1) == 1;}
+    bool pop(T& out){return pop_batch(&out, 1) == 1;}
+
+    //Pushes as many of the count items as there's room for, and returns how many it pushed.
+    size_t push_batch(const T* items, size_t count){
+        size_t t = producer.tail.load(std::memory_order_relaxed);
+        if(N - (t - producer.cached_head) < count){producer.cached_head = consumer.head.load(std::memory_order_acquire);}
+        size_t n = std::min(count, N - (t - producer.cached_head));
+        for(size_t i = 0; i < n; ++i){slots[(t + i) & (N - 1)] = items[i];}
+        producer.tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    //Pops up to count items into out, and returns how many it popped.
+    size_t pop_batch(T* out, size_t count){
+        size_t h = consumer.head.load(std::memory_order_relaxed);
+        if(consumer.cached_tail - h < count){consumer.cached_tail = producer.tail.load(std::memory_order_acquire);}
+        size_t n = std::min(count, consumer.cached_tail - h);
+        for(size_t i = 0; i < n; ++i){out[i] = std::move(slots[(h + i) & (N - 1)]);}
+        consumer.head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+
+    struct alignas(64) producer_state{
+        std::atomic<size_t> tail{0};
+        size_t cached_head = 0;
+    };
+
+    struct alignas(64) consumer_state{
+        std::atomic<size_t> head{0};
+        size_t cached_tail = 0;
+    };
+
+    producer_state producer;
+    consumer_state consumer;
+    alignas(64) std::array<T, N> slots;
+};
+
+//SPSC stands for single producer, single consumer: exactly one thread may push, and exactly one thread may pop.
+//The head and tail just count up forever, and are only turned into an index into the array by masking off the high bits.
+//This means that tail - head is always the number of elements in the buffer, even after they wrap around.
+//Each thread only writes to its own index, so no locks or compare-and-swap loops are needed. The release store of an index
+//makes sure that the elements written before it are visible to the other thread once it sees the new index with its acquire load.
+
+//The alignas(64) puts the producer's data, the consumer's data, and the elements on separate cache lines (which are 64 bytes on most processors).
+//Otherwise, every time one thread wrote its index the other thread's copy of the cache line would be thrown out, even though it
+//doesn't care about that variable. This is called false sharing.
+//Each side also keeps a cached copy of the other side's index, and only reloads the real one when the cached copy says the buffer is full (or empty).
+//The batch functions pay for the atomic operations once for the whole batch, instead of once per element.
+
+
+//If more than one thread needs to push or pop, each element needs to keep track of whether it's ready.
+//In the version below, every slot has a sequence number. A slot at position pos is ready to be written when its sequence is pos,
+//and ready to be read when its sequence is pos + 1. A thread claims positions by moving the shared index forward with compare_exchange,
+//and after it's done with a slot it updates that slot's sequence to hand it to the other side.
+
+template<typename T, size_t N>
+class mpmc_ring{
+public:
+
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the capacity must be a power of two");
+
+    mpmc_ring(){for(size_t i = 0; i < N; ++i){slots[i].sequence.store(i, std::memory_order_relaxed);}}
+
+    bool push(const T& val){return push_batch(&val, 1) == 1;}
+    bool pop(T& out){return pop_batch(&out, 1) == 1;}
+
+    size_t push_batch(const T* items, size_t count){
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while(true){
+            size_t n = 0;
+            while(n < count && slots[(pos + n) & (N - 1)].sequence.load(std::memory_order_acquire) == pos + n){++n;}
+            if(n == 0){
+                if(slots[pos & (N - 1)].sequence.load(std::memory_order_acquire) < pos){return 0;} //full
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(enqueue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)){
+                for(size_t i = 0; i < n; ++i){
+                    slot& s = slots[(pos + i) & (N - 1)];
+                    s.value = items[i];
+                    s.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    size_t pop_batch(T* out, size_t count){
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while(true){
+            size_t n = 0;
+            while(n < count && slots[(pos + n) & (N - 1)].sequence.load(std::memory_order_acquire) == pos + n + 1){++n;}
+            if(n == 0){
+                if(slots[pos & (N - 1)].sequence.load(std::memory_order_acquire) < pos + 1){return 0;} //empty
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)){
+                for(size_t i = 0; i < n; ++i){
+                    slot& s = slots[(pos + i) & (N - 1)];
+                    out[i] = std::move(s.value);
+                    s.sequence.store(pos + i + N, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+private:
+
+    struct alignas(64) slot{
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) std::atomic<size_t> dequeue_pos{0};
+    std::array<slot, N> slots;
+};
+
+//A batch only claims the run of slots that are all ready, so one compare_exchange covers the whole batch.
+//If compare_exchange fails, another thread claimed those positions first, and pos is updated to the current value so the loop can try again.
+//Each slot is on its own cache line so that threads working on neighboring slots don't cause false sharing.
+//Both ring buffers require T to be default constructible, since the array of elements is created up front.
+
+
+
+//--------------------------------------------------
+//NON-TYPE PARAMETERS AS LAYOUTS
+//--------------------------------------------------
+
+//A non-type parameter can decide more than just the size of an array. Sometimes a whole data structure's layout can be worked out from a few numbers,
+//and if those numbers are template parameters, all of that work is done by the compiler.
+//A good example is a latency histogram. To report something like "99% of calls took less than 12 microseconds", you need to count how often each duration happened.
+//Having a counter for every possible value would take far too much memory, but you rarely care about the exact number:
+//knowing that a call took 12.3 microseconds instead of 12.34 is usually good enough.
+//An HDR (high dynamic range) histogram takes advantage of this. It keeps a fixed number of significant digits for every value,
+//so the buckets for small values are narrow, and the buckets for large values are wide.
+
+//The buckets are arranged in groups. The first group covers 0 to sub_bucket_count - 1 exactly, and each group after that
+//covers twice the range of the previous one with buckets that are twice as wide. sub_bucket_count is the smallest power of two
+//that's at least 2 * 10^SigFigs, which is enough for every value to be within 1 part in 10^SigFigs of its bucket.
+
+template<unsigned long long MaxValue, int SigFigs>
+struct hdr_layout{
+
+    static_assert(SigFigs >= 1 && SigFigs <= 5, "SigFigs must be between 1 and 5");
+
+    static constexpr int sub_bucket_magnitude = []{
+        unsigned long long largest = 2;
+        for(int i = 0; i < SigFigs; ++i){largest *= 10;}
+        int magnitude = 0;
+        while((1ULL << magnitude) < largest){++magnitude;}
+        return magnitude;
+    }();
+
+    static constexpr unsigned long long sub_bucket_count = 1ULL << sub_bucket_magnitude;
+    static constexpr unsigned long long sub_bucket_half_count = sub_bucket_count / 2;
+    static constexpr int sub_bucket_half_magnitude = sub_bucket_magnitude - 1;
+    static constexpr unsigned long long sub_bucket_mask = sub_bucket_count - 1;
+
+    static constexpr int bucket_count = []{
+        unsigned long long smallest_untracked = sub_bucket_count;
+        int buckets = 1;
+        while(smallest_untracked <= MaxValue){
+            if(smallest_untracked > ~0ULL / 2){return buckets + 1;}
+            smallest_untracked <<= 1;
+            ++buckets;
+        }
+        return buckets;
+    }();
+
+    static constexpr size_t counts_length = (bucket_count + 1) * sub_bucket_half_count;
+
+    static constexpr int bitWidth(unsigned long long v){
+#if defined(__GNUC__)
+        return 64 - __builtin_clzll(v);
+#else
+        int width = 0;
+        while(v){v >>= 1; ++width;}
+        return width;
+#endif
+    }
+
+    //Finds which counter a value goes in. The group is found from the position of the value's highest bit,
+    //and the bucket within the group is the value shifted right by the group number.
+    static constexpr size_t index(unsigned long long value){
+        int bucket = bitWidth(value | sub_bucket_mask) - (sub_bucket_half_magnitude + 1);
+        unsigned long long sub_bucket = value >> bucket;
+        return (static_cast<size_t>(bucket + 1) << sub_bucket_half_magnitude) + static_cast<size_t>(sub_bucket - sub_bucket_half_count);
+    }
+
+    //The largest value that would be counted in the same counter as index i.
+    static constexpr unsigned long long highestValue(size_t i){
+        int bucket = static_cast<int>(i >> sub_bucket_half_magnitude) - 1;
+        unsigned long long sub_bucket = (i & (sub_bucket_half_count - 1)) + sub_bucket_half_count;
+        if(bucket < 0){
+            sub_bucket -= sub_bucket_half_count;
+            bucket = 0;
+        }
+        return (sub_bucket << bucket) + (1ULL << bucket) - 1;
+    }
+
+    static_assert(index(MaxValue) < counts_length, "the layout must have a counter for MaxValue");
+};
+
+//The first group uses the whole range of sub buckets, but every later group only uses the top half,
+//since the bottom half of its range is already covered by the group before it. That's why there are (bucket_count + 1) half groups of counters.
+//For example, hdr_layout<3600000000, 3> (up to an hour in microseconds, to 3 significant digits) has 2048 sub buckets and 22 groups,
+//for a total of 23552 counters. Since index is constexpr, the static_assert at the end checks that the largest value actually fits.
+
+//The histogram itself keeps several copies (shards) of the counters. Each thread is given a shard the first time it records a value,
+//and recording is just a single relaxed fetch_add, so it always finishes in a fixed number of steps no matter what other threads are doing (it's wait-free).
+//Threads could all share one set of counters, but then threads recording similar values would keep fighting over the same cache lines.
+//If there are more threads than shards, some threads share a shard, which is still correct since the counters are atomic.
+
+template<unsigned long long MaxValue, int SigFigs, size_t Shards = 8>
+class hdr_histogram{
+public:
+
+    using layout = hdr_layout<MaxValue, SigFigs>;
+
+    hdr_histogram(): shards(new shard[Shards]){}
+
+    //Values above MaxValue are counted as MaxValue, so recording never fails.
+    void record(unsigned long long value, unsigned long long count = 1){
+        size_t i = layout::index(value < MaxValue ? value : MaxValue);
+        shards[localShard()].counts[i].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    //Adds up the shards into plain counters. Other threads can keep recording while this runs.
+    std::vector<unsigned long long> totals() const {
+        std::vector<unsigned long long> result(layout::counts_length);
+        for(size_t s = 0; s < Shards; ++s){
+            for(size_t i = 0; i < layout::counts_length; ++i){result[i] += shards[s].counts[i].load(std::memory_order_relaxed);}
+        }
+        return result;
+    }
+
+    //Only histograms with the same layout can be merged. The number of shards doesn't matter, since it doesn't change the layout.
+    template<size_t OtherShards>
+    void merge(const hdr_histogram<MaxValue, SigFigs, OtherShards>& other){
+        std::vector<unsigned long long> other_totals = other.totals();
+        for(size_t i = 0; i < layout::counts_length; ++i){
+            if(other_totals[i]){shards[0].counts[i].fetch_add(other_totals[i], std::memory_order_relaxed);}
+        }
+    }
+
+    //Returns the value that p percent of the recorded values are less than or equal to (within the histogram's precision).
+    unsigned long long percentile(double p) const {
+        std::vector<unsigned long long> counts = totals();
+        unsigned long long total = 0;
+        for(unsigned long long c : counts){total += c;}
+        if(total == 0){return 0;}
+        unsigned long long target = static_cast<unsigned long long>(p / 100.0 * static_cast<double>(total) + 0.5);
+        if(target == 0){target = 1;}
+        unsigned long long seen = 0;
+        for(size_t i = 0; i < counts.size(); ++i){
+            seen += counts[i];
+            if(seen >= target){return std::min(layout::highestValue(i), MaxValue);}
+        }
+        return MaxValue;
+    }
+
+    //Writes the counters in a compact binary form: a header holding the layout, followed by the counters as variable length integers.
+    //Most of the counters are usually zero, so a run of zeros is written as a single negative number.
+    std::vector<unsigned char> snapshot() const {
+        std::vector<unsigned char> out = {'H', 'D', 'R', '1', static_cast<unsigned char>(SigFigs)};
+        writeVarint(out, MaxValue);
+        std::vector<unsigned long long> counts = totals();
+        for(size_t i = 0; i < counts.size();){
+            size_t zeros = 0;
+            while(i + zeros < counts.size() && counts[i + zeros] == 0){++zeros;}
+            if(zeros > 0){
+                writeVarint(out, zigzag(-static_cast<long long>(zeros)));
+                i += zeros;
+            }else{
+                writeVarint(out, zigzag(static_cast<long long>(counts[i])));
+                ++i;
+            }
+        }
+        return out;
+    }
+
+    //Adds the counts in a snapshot to this histogram. Returns false (without changing anything) if the snapshot
+    //is corrupted or was written by a histogram with a different layout.
+    bool merge_snapshot(const unsigned char* data, size_t size){
+        const unsigned char* end = data + size;
+        unsigned long long max_value = 0;
+        if(size < 5 || data[0] != 'H' || data[1] != 'D' || data[2] != 'R' || data[3] != '1' || data[4] != SigFigs){return false;}
+        data += 5;
+        if(!readVarint(data, end, max_value) || max_value != MaxValue){return false;}
+        std::vector<unsigned long long> counts(layout::counts_length);
+        size_t i = 0;
+        while(data != end){
+            unsigned long long encoded = 0;
+            if(!readVarint(data, end, encoded)){return false;}
+            if(encoded & 1){ //a negative number, which is a run of zeros
+                unsigned long long zeros = (encoded >> 1) + 1;
+                if(zeros > counts.size() - i){return false;}
+                i += static_cast<size_t>(zeros);
+            }else{
+                if(i == counts.size()){return false;}
+                counts[i++] = encoded >> 1;
+            }
+        }
+        if(i != counts.size()){return false;} //every counter is written, even the zeros at the end, so anything shorter was cut off
+        for(size_t j = 0; j < counts.size(); ++j){
+            if(counts[j]){shards[0].counts[j].fetch_add(counts[j], std::memory_order_relaxed);}
+        }
+        return true;
+    }
+
+private:
+
+    struct alignas(64) shard{
+        std::array<std::atomic<unsigned long long>, layout::counts_length> counts{};
+    };
+
+    static size_t localShard(){
+        static std::atomic<size_t> next_shard{0};
+        thread_local size_t s = next_shard.fetch_add(1, std::memory_order_relaxed) % Shards;
+        return s;
+    }
+
+    static unsigned long long zigzag(long long v){return (static_cast<unsigned long long>(v) << 1) ^ static_cast<unsigned long long>(v >> 63);}
+
+    static void writeVarint(std::vector<unsigned char>& out, unsigned long long v){
+        while(v >= 0x80){
+            out.push_back(static_cast<unsigned char>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(v));
+    }
+
+    static bool readVarint(const unsigned char*& data, const unsigned char* end, unsigned long long& v){
+        v = 0;
+        for(int shift = 0; shift < 64 && data != end; shift += 7){
+            unsigned char byte = *data++;
+            if(shift == 63 && (byte & 0x7E)){return false;} //the 10th byte only has room for the 64th bit
+            v |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if(!(byte & 0x80)){return true;}
+        }
+        return false;
+    }
+
+    std::unique_ptr<shard[]> shards;
+};
+
+//Each variable length integer stores 7 bits per byte, and the top bit of each byte says whether there's another byte after it.
+//Zigzag encoding maps 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4... so small negative numbers (the runs of zeros) are small too.
+//When reading, the lowest bit says whether the number was negative. The run length is worked out with unsigned arithmetic,
+//since a corrupted snapshot could hold the most negative long long, which can't be negated.
+//A histogram with only a few distinct values recorded takes a few dozen bytes this way, instead of the 8 bytes per counter it takes in memory.
+//The shards are allocated on the heap, since the counters can easily add up to more than a thread's stack can hold.
+//Since the layout only depends on MaxValue and SigFigs, two histograms with different layouts are different types,
+//so merging them by accident is a build error. A snapshot doesn't have that protection, which is why its header records the layout.
+
+
 
 int main(){
     
@@ -292,6 +791,28 @@ int main(){
 	//Mixing both methods
 	exampleFunc1<double>('c', 5.0);
     
+    //Printing with a format string that was parsed at compile time
+    print<greeting>("Alice", 30);
+    
+    //A ring buffer with a capacity of 8 ints, checked at compile time to be a power of two
+    spsc_ring<int, 8> ring;
+    int values[] = {1, 2, 3};
+    ring.push_batch(values, 3);
+    int popped = 0;
+    while(ring.pop(popped)){std::cout << popped << ' ';}
+    std::cout << std::endl;
+    
+    //Timing exampleFunc5 in nanoseconds, up to one second, to 2 significant digits
+    hdr_histogram<1000000000, 2> latencies;
+    for(int i = 0; i < 10000; ++i){
+        auto start = std::chrono::steady_clock::now();
+        volatile int max = exampleFunc5(v1);
+        (void)max;
+        latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::cout << latencies.percentile(50) << "ns median, " << latencies.percentile(99) << "ns 99th percentile, "
+              << latencies.snapshot().size() << " byte snapshot" << std::endl;
+    
     
 	return 0;
 }
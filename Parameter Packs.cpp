@@ -1,6 +1,28 @@
 #include <vector>
 #include <array>
 #include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 template<typename... Args, template<typename> class ...Args1, typename... Args2>
 void exampleFunc1();
@@ -117,12 +139,565 @@ std::array<int, 4> exampleFunc3(){
 //If this behavior is undesirable, you should use the binary fold expressions instead, and make the additional expression your desired default.
 
 
+//--------------------------------------------------
+//USING A PACK AS A LIST OF OPTIONS
+//--------------------------------------------------
+
+//A non-type parameter pack is a handy way to give a class a list of options that are known at compile time.
+//Since sizeof... is constexpr, the class can size its arrays to fit exactly the options it was given.
+//For example, on Linux you can ask the processor to count hardware events (like clock cycles or cache misses)
+//while a piece of code runs, using the perf_event_open system call. This class opens one counter per event in its pack,
+//starts them when it's created, and prints what they counted when it's destroyed:
+
+enum class perf_event{cycles, instructions, cache_misses, branch_misses};
+
+constexpr const char* perfEventName(perf_event e){
+    switch(e){
+        case perf_event::cycles: return "cycles";
+        case perf_event::instructions: return "instructions";
+        case perf_event::cache_misses: return "cache-misses";
+        case perf_event::branch_misses: return "branch-misses";
+    }
+    return "unknown";
+}
+
+template<perf_event ...Events>
+class perf_scope{
+public:
+
+    static_assert(sizeof...(Events) > 0, "perf_scope needs at least one event to count");
+
+    explicit perf_scope(std::string region): name(std::move(region)){
+#if defined(__linux__)
+        size_t i = 0;
+        ((fds[i] = openCounter(Events, i == 0 ? -1 : fds[0]), ++i), ...);
+        available = std::all_of(fds.begin(), fds.end(), [](int fd){return fd >= 0;});
+        if(available){
+            ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+
+    ~perf_scope(){
+        std::cout << name << ':';
+#if defined(__linux__)
+        struct{uint64_t count; uint64_t values[sizeof...(Events)];} data{};
+        if(available){
+            ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            available = read(fds[0], &data, sizeof(data)) == static_cast<ssize_t>(sizeof(data));
+        }
+        if(available){
+            size_t i = 0;
+            ((std::cout << ' ' << perfEventName(Events) << '=' << data.values[i++]), ...);
+        }
+        for(int fd : fds){if(fd >= 0){close(fd);}}
+#endif
+        if(!available){std::cout << " counters unavailable";}
+        std::cout << '\n';
+    }
+
+private:
+
+#if defined(__linux__)
+    static int openCounter(perf_event e, int group){
+        constexpr uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[static_cast<size_t>(e)];
+        attr.disabled = group == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+#endif
+
+    std::string name;
+    std::array<int, sizeof...(Events)> fds{};
+    bool available = false;
+};
+
+//The constructor uses a fold over the comma operator to open a counter for each event in order.
+//The first counter is the group leader, and every counter after it joins the leader's group, which means
+//that they're all started, stopped, and read together, so the numbers all describe exactly the same stretch of code.
+//The destructor uses another fold to print the counts, since the values come back in the same order the counters were opened.
+
+//You use it by putting it at the start of the block you want to measure:
+//    {
+//        perf_scope<perf_event::cycles, perf_event::instructions, perf_event::cache_misses> scope("exampleFunc3");
+//        auto a = exampleFunc3<1, 2, 3, 4>();
+//    }
+//When the block ends, it prints something like "exampleFunc3: cycles=1234 instructions=2345 cache-misses=3".
+//Counters aren't always available: perf_event_open may be turned off by the kernel's perf_event_paranoid setting,
+//blocked inside containers and virtual machines, or just not exist on other operating systems.
+//In any of these cases the scope still compiles and runs, it just says that the counters were unavailable instead of printing numbers.
+
+
+//--------------------------------------------------
+//PACKS OF STAGES: LAZY PIPELINES
+//--------------------------------------------------
+
+//In exampleFunc2, the pattern sizeof(args)... builds a whole std::vector just to hold the sizes.
+//When you chain several steps like that (transform the elements, then keep some of them, then add them up),
+//each step usually creates another container, and every element is read and written once per step.
+//Instead, you can collect the steps themselves into a parameter pack, and only run them at the very end,
+//in one loop that sends each element through every step before moving on to the next element.
+
+//Each kind of step is a small struct holding the function it uses:
+
+template<typename F>
+struct map_stage{F func;};
+
+template<typename F>
+struct filter_stage{F func;};
+
+struct take_stage{size_t count;};
+
+template<typename F>
+map_stage<F> map(F f){return {f};}
+
+template<typename F>
+filter_stage<F> filter(F f){return {f};}
+
+inline take_stage take(size_t count){return {count};}
+
+//Traits that say which kind of step a type is:
+
+template<typename T>
+struct is_map_stage{static constexpr bool value = false;};
+
+template<typename F>
+struct is_map_stage<map_stage<F>>{static constexpr bool value = true;};
+
+template<typename T>
+struct is_filter_stage{static constexpr bool value = false;};
+
+template<typename F>
+struct is_filter_stage<filter_stage<F>>{static constexpr bool value = true;};
+
+template<typename T>
+constexpr bool is_stage_v = is_map_stage<T>::value || is_filter_stage<T>::value || std::is_same_v<T, take_stage>;
+
+//True when every step is a map except the last one, which is a filter:
+
+template<typename ...Stages>
+struct maps_then_filter{static constexpr bool value = false;};
+
+template<typename Last>
+struct maps_then_filter<Last>{static constexpr bool value = is_filter_stage<Last>::value;};
+
+template<typename First, typename Second, typename ...Rest>
+struct maps_then_filter<First, Second, Rest...>{static constexpr bool value = is_map_stage<First>::value && maps_then_filter<Second, Rest...>::value;};
+
+template<typename ...Stages>
+constexpr bool maps_then_filter_v = maps_then_filter<Stages...>::value;
+
+template<typename T>
+struct type_tag{using type = T;};
+
+//A view holds a pointer to the range it reads from and a tuple of all of its steps.
+
+template<typename Range, typename ...Stages>
+struct view{
+
+    static constexpr size_t stage_count = sizeof...(Stages);
+
+    const Range* range;
+    std::tuple<Stages...> stages;
+
+    //Sends every element through the steps, and passes the ones that make it through to sink.
+    template<typename Sink>
+    void run(Sink&& sink) const {
+        std::array<size_t, stage_count> taken{};
+        for(const auto& val : *range){
+            if(!step<0>(val, sink, taken)){break;}
+        }
+    }
+
+    //Returns false once a take step has taken everything it needs, since no more elements can get through.
+    template<size_t I, typename T, typename Sink>
+    bool step(T&& val, Sink& sink, std::array<size_t, stage_count>& taken) const {
+        if constexpr(I == stage_count){
+            sink(std::forward<T>(val));
+            return true;
+        }else{
+            using S = std::tuple_element_t<I, std::tuple<Stages...>>;
+            const S& stage = std::get<I>(stages);
+            if constexpr(is_map_stage<S>::value){
+                return step<I + 1>(stage.func(std::forward<T>(val)), sink, taken);
+            }else if constexpr(is_filter_stage<S>::value){
+                return stage.func(val) ? step<I + 1>(std::forward<T>(val), sink, taken) : true;
+            }else{
+                if(taken[I] == stage.count){return false;}
+                ++taken[I];
+                return step<I + 1>(std::forward<T>(val), sink, taken) && taken[I] < stage.count;
+            }
+        }
+    }
+
+    //Figures out the type of the elements that come out of the last step, without running anything.
+    template<size_t I, typename T>
+    static auto output(){
+        if constexpr(I == stage_count){return type_tag<std::decay_t<T>>{};}
+        else{
+            using S = std::tuple_element_t<I, std::tuple<Stages...>>;
+            if constexpr(is_map_stage<S>::value){return output<I + 1, decltype(std::declval<const S&>().func(std::declval<T>()))>();}
+            else{return output<I + 1, T>();}
+        }
+    }
+
+    using value_type = typename decltype(output<0, decltype(*std::begin(std::declval<const Range&>()))>())::type;
+
+    //The most elements that can come out of the view. It's exact when there aren't any filter steps.
+    size_t max_size() const {
+        size_t n = static_cast<size_t>(std::distance(std::begin(*range), std::end(*range)));
+        std::apply([&n](const auto&... stage){
+            ((n = takeLimit(stage, n)), ...);
+        }, stages);
+        return n;
+    }
+
+    static constexpr bool has_filter = (is_filter_stage<Stages>::value || ...);
+
+    static constexpr bool maps_then_filter = maps_then_filter_v<Stages...>;
+
+    //Runs an element through every step but the last.
+    template<size_t I, typename T>
+    auto applyMaps(T&& val) const {
+        if constexpr(I + 1 >= stage_count){return std::forward<T>(val);}
+        else{return applyMaps<I + 1>(std::get<I>(stages).func(std::forward<T>(val)));}
+    }
+
+private:
+    template<typename S>
+    static size_t takeLimit(const S& stage, size_t n){
+        if constexpr(std::is_same_v<S, take_stage>){return std::min(n, stage.count);}
+        else{return n;}
+    }
+};
+
+//The | operator starts a view from a range, or adds another step to the end of an existing view.
+//The second overload is more specialized than the first, so it's picked whenever the left side is already a view.
+
+template<typename Range, typename Stage, typename = std::enable_if_t<is_stage_v<Stage>>>
+view<Range, Stage> operator|(const Range& range, Stage stage){return {&range, std::tuple<Stage>(stage)};}
+
+template<typename Range, typename ...Stages, typename Stage, typename = std::enable_if_t<is_stage_v<Stage>>>
+view<Range, Stages..., Stage> operator|(const view<Range, Stages...>& v, Stage stage){
+    return {v.range, std::tuple_cat(v.stages, std::tuple<Stage>(stage))};
+}
+
+//Nothing happens until the view reaches a terminal step. reduce combines every element into a single value:
+
+template<typename T, typename F>
+struct reduce_stage{T init; F func;};
+
+template<typename T, typename F>
+reduce_stage<T, F> reduce(T init, F func){return {init, func};}
+
+template<typename Range, typename ...Stages, typename T, typename F>
+T operator|(const view<Range, Stages...>& v, reduce_stage<T, F> r){
+    T result = r.init;
+    v.run([&](auto&& val){result = r.func(result, std::forward<decltype(val)>(val));});
+    return result;
+}
+
+//to puts the elements into a container. It takes the container as a template template parameter, so you write to<std::vector>()
+//and the element type is filled in from the view.
+
+template<template<typename...> class Container>
+struct to_stage{};
+
+template<template<typename...> class Container>
+to_stage<Container> to(){return {};}
+
+//Not every container has reserve (std::list and std::deque don't), so to checks for it first:
+
+template<typename C, typename = void>
+struct has_reserve{static constexpr bool value = false;};
+
+template<typename C>
+struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(size_t()))>>{static constexpr bool value = true;};
+
+//A filter that ends a pipeline of numbers is sped up with a compaction kernel, which copies just the elements that pass from one array to another.
+//The scalar version is branchless: it always writes the element, then only moves the end forward if it passes.
+//There's no branch for the processor to mispredict, which matters when about half of the elements pass.
+
+template<typename T, typename Keep>
+size_t compactScalar(const T* in, size_t n, T* out, const Keep& keep){
+    size_t kept = 0;
+    for(size_t i = 0; i < n; ++i){
+        out[kept] = in[i];
+        kept += keep(in[i]) ? 1 : 0;
+    }
+    return kept;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+//For 4 byte numbers, the SIMD version works on 4 elements at a time. It checks each of them to make a 4 bit mask of the ones that pass,
+//then uses the mask to look up a shuffle that moves the passing elements to the front of the register, in order.
+//The whole register is stored, but the end only moves forward by the number of elements that passed, so the rest get overwritten next time.
+//Moving lanes around by a value only known at runtime needs the pshufb instruction from SSSE3 (SSE2 can only shuffle by a constant),
+//so this is compiled with the target attribute, like the kernels in the SFINAE section.
+
+inline constexpr auto left_pack_table = []{
+    std::array<std::array<unsigned char, 16>, 16> table{};
+    for(int mask = 0; mask < 16; ++mask){
+        int lane = 0;
+        for(int i = 0; i < 4; ++i){
+            if(mask & (1 << i)){
+                for(int b = 0; b < 4; ++b){table[mask][lane * 4 + b] = static_cast<unsigned char>(i * 4 + b);}
+                ++lane;
+            }
+        }
+        for(int b = lane * 4; b < 16; ++b){table[mask][b] = 0x80;} //0x80 makes pshufb write a zero
+    }
+    return table;
+}();
+
+template<typename T, typename Keep>
+__attribute__((target("ssse3")))
+size_t compactSsse3(const T* in, size_t n, T* out, const Keep& keep){
+    static_assert(sizeof(T) == 4, "the SIMD kernel works on 4 byte elements");
+    size_t kept = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        unsigned mask = unsigned(bool(keep(in[i]))) | unsigned(bool(keep(in[i + 1]))) << 1 |
+                        unsigned(bool(keep(in[i + 2]))) << 2 | unsigned(bool(keep(in[i + 3]))) << 3;
+        __m128i vals = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        vals = _mm_shuffle_epi8(vals, _mm_loadu_si128(reinterpret_cast<const __m128i*>(left_pack_table[mask].data())));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + kept), vals);
+        kept += static_cast<size_t>(__builtin_popcount(mask));
+    }
+    return kept + compactScalar(in + i, n - i, out + kept, keep);
+}
+
+#endif
+
+template<typename T, typename Keep>
+size_t compact(const T* in, size_t n, T* out, const Keep& keep){
+#if defined(__x86_64__) && defined(__GNUC__)
+    if constexpr(sizeof(T) == 4){
+        static const bool ssse3 = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3"));
+        if(ssse3){return compactSsse3(in, n, out, keep);}
+    }
+#endif
+    return compactScalar(in, n, out, keep);
+}
+
+//Both versions write at most as many elements as they read, and the SIMD version never writes past out + n,
+//since out + kept + 4 is never past out + i + 4.
+
+template<typename Range, typename ...Stages, template<typename...> class Container>
+Container<typename view<Range, Stages...>::value_type> operator|(const view<Range, Stages...>& v, to_stage<Container>){
+    using V = view<Range, Stages...>;
+    using T = typename V::value_type;
+    Container<T> result;
+    if constexpr(has_reserve<Container<T>>::value){result.reserve(v.max_size());}
+    if constexpr(V::maps_then_filter && std::is_arithmetic_v<T>){
+        //The elements are mapped into a small block on the stack, then the block is compacted and appended to the result.
+        constexpr size_t block = 256;
+        T in[block];
+        T out[block];
+        size_t filled = 0;
+        const auto& keep = std::get<V::stage_count - 1>(v.stages).func;
+        auto flush = [&]{
+            size_t kept = compact(in, filled, out, keep);
+            result.insert(result.end(), out, out + kept);
+            filled = 0;
+        };
+        for(const auto& val : *v.range){
+            in[filled++] = v.template applyMaps<0>(val);
+            if(filled == block){flush();}
+        }
+        flush();
+    }else{
+        v.run([&](auto&& val){result.push_back(std::forward<decltype(val)>(val));});
+    }
+    return result;
+}
+
+//So you can write this:
+//    std::vector<int> v1 = {1, 2, 3, 4, 5, 6, 7, 8};
+//    int sum = v1 | map([](int x){return x * x;}) | filter([](int x){return x % 2 == 0;}) | reduce(0, std::plus<>{});
+//    std::vector<int> firstThree = v1 | map([](int x){return x * 10;}) | take(3) | to<std::vector>();
+//The type of the first view is view<std::vector<int>, map_stage<lambda 1>, filter_stage<lambda 2>>, and run compiles into a single loop
+//with the square, the check, and the addition all inlined into it. No containers are created except the one to returns.
+//step uses if constexpr to pick what to do for each step, and recursion on the index I to get to the next step,
+//so there's no runtime cost for deciding what kind of step comes next.
+
+//If the container has reserve, to reserves max_size() elements ahead of time. Without a filter that's exactly the number of elements that come out,
+//so the container never reallocates. With a filter, it's only an upper bound, since the number of elements that pass isn't known until the end.
+//When the pipeline is any number of maps followed by a filter, and the elements are numbers, to goes through the compaction kernel a block at a time.
+//The blocks are small enough to stay in the cache, so copying them into the result is cheap, and the result never has to be filled with zeros first.
+
+//Since the view only holds a pointer to the range, the range needs to outlive the view.
+//Writing the whole pipeline in one expression, like in the examples above, makes sure of that.
+
+
+
+//--------------------------------------------------
+//GRIDS OF INSTANTIATIONS
+//--------------------------------------------------
+
+//Non-type parameters are often used for tuning: how many times to unroll a loop, how far ahead to prefetch, how big a block to work on.
+//The best values depend on the machine, so instead of guessing, you can instantiate every combination,
+//time them all on the machine the program is actually running on, and remember which one won.
+
+//Here's a kernel with two tuning parameters. Unroll is the number of separate running totals (which lets the processor work on several additions at once),
+//and Prefetch is how many elements ahead to ask the processor to start loading into the cache (0 means don't prefetch).
+
+template<size_t Unroll, size_t Prefetch>
+struct sum_variant{
+
+    static long long run(const int* data, size_t size){
+        long long totals[Unroll] = {};
+        size_t i = 0;
+        for(; i + Unroll <= size; i += Unroll){
+#if defined(__GNUC__)
+            if constexpr(Prefetch > 0){__builtin_prefetch(data + i + Prefetch);}
+#endif
+            for(size_t j = 0; j < Unroll; ++j){totals[j] += data[i + j];}
+        }
+        long long total = 0;
+        for(; i < size; ++i){total += data[i];}
+        for(long long t : totals){total += t;}
+        return total;
+    }
+
+    static std::string name(){return "unroll=" + std::to_string(Unroll) + " prefetch=" + std::to_string(Prefetch);}
+};
+
+//To make every combination of two lists of values, we need a list of types to hold the results, and a way to join lists together:
+
+template<typename ...Ts>
+struct type_list{};
+
+template<typename ...Lists>
+struct concat_lists{using type = type_list<>;};
+
+template<typename ...Ts>
+struct concat_lists<type_list<Ts...>>{using type = type_list<Ts...>;};
+
+template<typename ...Ts, typename ...Us, typename ...Rest>
+struct concat_lists<type_list<Ts...>, type_list<Us...>, Rest...>{using type = typename concat_lists<type_list<Ts..., Us...>, Rest...>::type;};
+
+template<size_t Unroll, size_t ...Prefetches>
+using sum_row = type_list<sum_variant<Unroll, Prefetches>...>;
+
+template<typename Unrolls, typename Prefetches>
+struct sum_grid;
+
+template<size_t ...Unrolls, size_t ...Prefetches>
+struct sum_grid<std::index_sequence<Unrolls...>, std::index_sequence<Prefetches...>>{
+    using type = typename concat_lists<sum_row<Unrolls, Prefetches...>...>::type;
+};
+
+//In sum_row<Unrolls, Prefetches...>..., there are two expansions. As mentioned at the start of this section, the innermost one happens first,
+//so Prefetches... is expanded inside each sum_row, and then the outer ... makes one sum_row for every value of Unrolls.
+//If you wrote type_list<sum_variant<Unrolls, Prefetches>...> instead, both packs would be expanded at the same time,
+//which would pair them up element by element (and fail to compile if they were different lengths).
+//So sum_grid<std::index_sequence<1, 4>, std::index_sequence<0, 64>>::type is
+//type_list<sum_variant<1, 0>, sum_variant<1, 64>, sum_variant<4, 0>, sum_variant<4, 64>>.
+
+//The tuner turns a list of variants into an array of function pointers, one per instantiation.
+//When it's created, it looks for the name of the best variant in a cache file. If it isn't there, it times every variant on a sample input
+//and writes the fastest one to the file, so the next time the program starts it can skip the timing.
+
+template<typename Grid>
+class tuned_kernel;
+
+template<typename ...Variants>
+class tuned_kernel<type_list<Variants...>>{
+public:
+
+    using function = long long(*)(const int*, size_t);
+
+    tuned_kernel(const std::string& kernel, const std::string& cache_path, const std::vector<int>& sample){
+        std::string names[] = {Variants::name()...};
+        std::ifstream in(cache_path);
+        std::string line;
+        while(std::getline(in, line)){
+            for(size_t i = 0; i < sizeof...(Variants); ++i){
+                if(line == kernel + ' ' + names[i]){chosen = i;}
+            }
+        }
+        if(chosen == npos){
+            chosen = fastest(sample);
+            std::ofstream(cache_path, std::ios::app) << kernel << ' ' << names[chosen] << '\n';
+        }
+        name = names[chosen];
+    }
+
+    long long operator()(const int* data, size_t size) const {return functions[chosen](data, size);}
+
+    const std::string& variant() const {return name;}
+
+private:
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr function functions[] = {&Variants::run...};
+
+    static size_t fastest(const std::vector<int>& sample){
+        size_t best = 0;
+        auto best_time = std::chrono::steady_clock::duration::max();
+        for(size_t i = 0; i < sizeof...(Variants); ++i){
+            auto best_of_variant = std::chrono::steady_clock::duration::max();
+            for(int rep = 0; rep < 5; ++rep){
+                auto start = std::chrono::steady_clock::now();
+                volatile long long result = functions[i](sample.data(), sample.size());
+                (void)result;
+                best_of_variant = std::min(best_of_variant, std::chrono::steady_clock::now() - start);
+            }
+            if(best_of_variant < best_time){
+                best_time = best_of_variant;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    size_t chosen = npos;
+    std::string name;
+};
+
+//The cache file stores the variant's name instead of its position in the list, so if you change the grid, an old entry
+//either still refers to the same instantiation or doesn't match anything and the tuner runs again.
+//Each variant is timed several times and only its best time counts, since the slower runs are mostly noise from the rest of the system.
+//The result goes through a volatile variable so the compiler can't skip the call for not using its result.
+//After the tuner is created, every call is just an indirect call through the chosen function pointer.
+
+
+
 int main(){
     
     auto a = exampleFunc3<1, 2, 3, 4>();
     
     for(int element : a){std::cout << element << std::endl;}
     
+    {
+        perf_scope<perf_event::cycles, perf_event::instructions, perf_event::branch_misses> scope("exampleFunc3");
+        a = exampleFunc3<1, 2, 3, 4>();
+    }
+    
+    std::vector<int> v1 = {1, 2, 3, 4, 5, 6, 7, 8};
+    int sum = v1 | map([](int x){return x * x;}) | filter([](int x){return x % 2 == 0;}) | reduce(0, std::plus<>{});
+    std::vector<int> evens = v1 | filter([](int x){return x % 2 == 0;}) | to<std::vector>();
+    std::vector<int> firstThree = v1 | map([](int x){return x * 10;}) | take(3) | to<std::vector>();
+    std::cout << sum << ' ' << evens.size() << ' ' << firstThree.back() << std::endl;
+    
+    using grid = sum_grid<std::index_sequence<1, 2, 4, 8>, std::index_sequence<0, 64>>::type;
+    std::string cachePath = (std::filesystem::temp_directory_path() / "template_guide_tuning.txt").string(); //Kept out of the current directory
+    tuned_kernel<grid> tunedSum("sum", cachePath, std::vector<int>(1 << 20, 1));
+    std::cout << tunedSum(v1.data(), v1.size()) << " using " << tunedSum.variant() << std::endl;
+    
     
     return 0;
 }
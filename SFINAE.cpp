@@ -0,0 +1,272 @@
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+
+//--------------------------------------------------
+//SFINAE
+//--------------------------------------------------
+
+//When the compiler is figuring out which overload of a function template to call, it substitutes the template arguments
+//into the declaration of each candidate. Sometimes that substitution produces something invalid, like T::value_type where T is int.
+//Rather than making this a build error, the compiler just removes that candidate from the overload set and keeps going.
+//This rule is called "substitution failure is not an error", or SFINAE.
+
+template<typename T>
+typename T::value_type exampleFunc1(const T& container){std::cout << "Container overload called\n"; return *container.begin();}
+
+template<typename T>
+T exampleFunc1(T val){std::cout << "Non-container overload called\n"; return val;}
+
+//If you call exampleFunc1(5), substituting int into the first overload produces int::value_type, which is invalid.
+//So the first overload is thrown out, and the second one is called. If you call it with a std::vector<int>, both overloads are valid,
+//and since partial ordering ignores the reference and the const, neither one is more specialized than the other, so the call is ambiguous.
+//This is a good example of why SFINAE is usually used in a more controlled way.
+
+//Note that this only applies to the immediate context of the declaration: the function's signature and template parameter list.
+//If substitution works but the body of the function doesn't compile, that's a regular build error.
+
+
+
+//--------------------------------------------------
+//STD::ENABLE_IF
+//--------------------------------------------------
+
+//std::enable_if is a class template defined in the type_traits header that makes it easy to cause a substitution failure on purpose.
+//It's essentially defined like this:
+
+template<bool B, typename T = void>
+struct enable_if{};
+
+template<typename T>
+struct enable_if<true, T>{using type = T;};
+
+template<bool B, typename T = void>
+using enable_if_t = typename enable_if<B, T>::type;
+
+//If the condition is true, enable_if<B, T>::type is T. If it's false, there is no type member, so using it is a substitution failure.
+//This lets you turn an overload on or off with any compile time boolean.
+//There are three common places to put it: the return type, a defaulted template parameter, or a defaulted function parameter.
+
+template<typename T>
+std::enable_if_t<std::is_integral_v<T>, T> exampleFunc2(T val){std::cout << "Integral overload called\n"; return val;} //return type
+
+template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+T exampleFunc3(T val){std::cout << "Floating point overload called\n"; return val;} //template parameter
+
+template<typename T>
+T exampleFunc4(T val, std::enable_if_t<std::is_pointer_v<T>>* = nullptr){std::cout << "Pointer overload called\n"; return val;} //function parameter
+
+//Be careful with the template parameter form. Default template arguments aren't part of the function's signature,
+//so two overloads that only differ in the condition in their defaulted template parameter are redefinitions of the same template.
+//If you need more than one overload, use the return type, or write the template parameter as
+//    std::enable_if_t<condition, int> = 0
+//since then the condition is part of the type of the parameter.
+
+//When you use enable_if to pick between several overloads, you have to make sure that the conditions never overlap.
+//Otherwise, the call is ambiguous, since none of the overloads are more specialized than the others.
+
+//This also gives you another way to "specialize" a member function template without specializing the class, like in the previous section:
+
+template<typename T>
+struct A{
+    template<typename T1>
+    std::enable_if_t<std::is_same_v<T1, int>> func(T1 val){std::cout << "\"Specialization\" for int called\n";}
+
+    template<typename T1>
+    std::enable_if_t<!std::is_same_v<T1, int>> func(T1 val){std::cout << "\"Base\" template called\n";}
+};
+
+
+
+//--------------------------------------------------
+//SELECTING OVERLOADS WITH TAGS
+//--------------------------------------------------
+
+//A practical use of this is writing different versions of a function for different processors.
+//Most x86-64 processors support instructions that work on several numbers at once (SIMD), but which instructions they support depends on their age.
+//Every x86-64 processor supports SSE2, which works on 128 bits at once. Newer ones support AVX2 (256 bits), and some support AVX-512 (512 bits).
+//If you want a single program to use the best instructions available on whatever machine it's run on, you need to
+//compile every version of the function, then pick between them when the program starts.
+
+//First, each instruction set gets a tag type. The level is just a number that says which instruction sets are newer:
+
+template<int Level>
+struct isa_tag{static constexpr int level = Level;};
+
+using scalar_isa = isa_tag<0>;
+using sse2_isa = isa_tag<1>;
+using avx2_isa = isa_tag<2>;
+using avx512_isa = isa_tag<3>;
+
+//Then, each version of the function is enabled for exactly one tag.
+//The scalar version is written in plain C++, so it works everywhere, including on processors that aren't x86-64 at all.
+
+template<typename ISA>
+std::enable_if_t<ISA::level == scalar_isa::level, int> sumKernel(const int* data, size_t size){
+    int total = 0;
+    for(size_t i = 0; i < size; ++i){total += data[i];}
+    return total;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+//The other versions use intrinsics, which are functions that compile to a specific instruction.
+//The target attribute (which is specific to GCC and Clang) lets the compiler use AVX2 or AVX-512 instructions in just that function,
+//even when the rest of the program is compiled for a processor that doesn't have them.
+
+template<typename ISA>
+std::enable_if_t<ISA::level == sse2_isa::level, int> sumKernel(const int* data, size_t size){
+    __m128i total = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 4 <= size; i += 4){total = _mm_add_epi32(total, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));}
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(total) + sumKernel<scalar_isa>(data + i, size - i);
+}
+
+template<typename ISA>
+__attribute__((target("avx2")))
+std::enable_if_t<ISA::level == avx2_isa::level, int> sumKernel(const int* data, size_t size){
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){total = _mm256_add_epi32(total, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));}
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half) + sumKernel<scalar_isa>(data + i, size - i);
+}
+
+template<typename ISA>
+__attribute__((target("avx512f")))
+std::enable_if_t<ISA::level == avx512_isa::level, int> sumKernel(const int* data, size_t size){
+    __m512i total = _mm512_setzero_si512();
+    size_t i = 0;
+    for(; i + 16 <= size; i += 16){total = _mm512_add_epi32(total, _mm512_loadu_si512(data + i));}
+    __m256i half = _mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xFF, total, 0), _mm512_maskz_extracti64x4_epi64(0xFF, total, 1));
+    __m128i quarter = _mm_add_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+    quarter = _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, _MM_SHUFFLE(1, 0, 3, 2)));
+    quarter = _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(quarter) + sumKernel<scalar_isa>(data + i, size - i);
+}
+
+#endif
+
+//The AVX-512 version adds the two halves of its register together and then finishes the same way as the AVX2 version.
+//There's an intrinsic that does all of this at once (_mm512_reduce_add_epi32), but with GCC 12 it causes a "used uninitialized" warning.
+//So do the plain extract and cast intrinsics, since they leave the unused part of a register undefined. The maskz versions with
+//every bit of the mask set do the same thing, but fill that part with zeros instead, which keeps the compiler quiet.
+
+//Since the tag is a template parameter, sumKernel<avx2_isa>(data, size) calls the AVX2 version directly, with no runtime check at all.
+//This is useful if you already know what machine the code is going to run on.
+
+//Otherwise, you can pick the version when the program starts. GCC and Clang provide __builtin_cpu_supports, which uses the
+//CPUID instruction to check which instruction sets the processor has. The resolver checks from newest to oldest,
+//and returns a pointer to the first version that the processor supports:
+
+using sum_func = int(*)(const int*, size_t);
+
+inline sum_func resolveSum(){
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){return &sumKernel<avx512_isa>;}
+    if(__builtin_cpu_supports("avx2")){return &sumKernel<avx2_isa>;}
+    return &sumKernel<sse2_isa>;
+#else
+    return &sumKernel<scalar_isa>;
+#endif
+}
+
+inline const sum_func sum = resolveSum();
+
+//sum is initialized before main() starts, so the check only ever happens once.
+//After that, every call to sum(data, size) is just a call through a function pointer, which costs about the same as calling a function in a shared library.
+//Taking the address of sumKernel<avx512_isa> is what instantiates it, and enable_if makes sure that each address refers to exactly one overload.
+//Since the versions are only ever called on processors that support them, the program will run on any x86-64 machine.
+
+//The same pattern works for any kernel. Here's a family of functions that copy an array, where each version moves as many bytes
+//as its registers hold at once. Memory copies are a good fit for this, since they're limited by how much data each instruction can move.
+
+template<typename ISA>
+std::enable_if_t<ISA::level == scalar_isa::level> copyKernel(int* dest, const int* src, size_t size){
+    for(size_t i = 0; i < size; ++i){dest[i] = src[i];}
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+template<typename ISA>
+std::enable_if_t<ISA::level == sse2_isa::level> copyKernel(int* dest, const int* src, size_t size){
+    size_t i = 0;
+    for(; i + 4 <= size; i += 4){_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));}
+    copyKernel<scalar_isa>(dest + i, src + i, size - i);
+}
+
+template<typename ISA>
+__attribute__((target("avx2")))
+std::enable_if_t<ISA::level == avx2_isa::level> copyKernel(int* dest, const int* src, size_t size){
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));}
+    copyKernel<scalar_isa>(dest + i, src + i, size - i);
+}
+
+template<typename ISA>
+__attribute__((target("avx512f")))
+std::enable_if_t<ISA::level == avx512_isa::level> copyKernel(int* dest, const int* src, size_t size){
+    size_t i = 0;
+    for(; i + 16 <= size; i += 16){_mm512_storeu_si512(dest + i, _mm512_loadu_si512(src + i));}
+    copyKernel<scalar_isa>(dest + i, src + i, size - i);
+}
+
+#endif
+
+//The resolver is the same as before, just with a different function pointer type. Each family gets its own resolver,
+//so adding a new kernel doesn't change the ones that already exist.
+
+using copy_func = void(*)(int*, const int*, size_t);
+
+inline copy_func resolveCopy(){
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){return &copyKernel<avx512_isa>;}
+    if(__builtin_cpu_supports("avx2")){return &copyKernel<avx2_isa>;}
+    return &copyKernel<sse2_isa>;
+#else
+    return &copyKernel<scalar_isa>;
+#endif
+}
+
+inline const copy_func copyInts = resolveCopy();
+
+//The source and destination must not overlap, just like with std::memcpy.
+//In practice std::memcpy already picks the best instructions for the processor in much the same way, so this is mostly useful
+//as a template for kernels that the standard library doesn't provide, like copying while converting between types.
+
+
+
+int main(){
+
+    exampleFunc1(5);
+    exampleFunc2(5);
+    exampleFunc3(5.0);
+    exampleFunc4("Hello");
+
+    A<double> a;
+    a.func(5);
+    a.func(5.0);
+
+    std::vector<int> v(1000);
+    for(size_t i = 0; i < v.size(); ++i){v[i] = static_cast<int>(i);}
+
+    std::cout << sumKernel<scalar_isa>(v.data(), v.size()) << ' ' << sum(v.data(), v.size()) << std::endl;
+
+    std::vector<int> copied(v.size());
+    copyInts(copied.data(), v.data(), v.size());
+    std::cout << (copied == v) << std::endl;
+
+    return 0;
+}
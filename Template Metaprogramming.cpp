@@ -0,0 +1,185 @@
+#include <iostream>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+
+//--------------------------------------------------
+//TEMPLATE METAPROGRAMMING
+//--------------------------------------------------
+
+//Template metaprogramming is using templates to perform computations at compile time.
+//You've already seen a few small examples of this: is_same in the template specialization section is a function that takes two types
+//and returns a bool, and the fold expressions in the parameter packs section compute values out of a list of template arguments.
+//The "inputs" of a metaprogram are template arguments, and the "outputs" are types, constants, or code that's only compiled when it's needed.
+
+//The classic example is computing a value recursively using specializations as the base case:
+
+template<unsigned N>
+struct factorial{static constexpr unsigned long long value = N * factorial<N - 1>::value;};
+
+template<>
+struct factorial<0>{static constexpr unsigned long long value = 1;};
+
+//factorial<5>::value instantiates factorial<4>, which instantiates factorial<3>, and so on until it hits the specialization for 0.
+//Since C++14, most computations like this are easier to write as a constexpr function. Templates are still needed when
+//the thing being computed is a type, or when the inputs are types, like the transitions in the state machine below.
+
+
+
+//--------------------------------------------------
+//COMPILE TIME STATE MACHINES
+//--------------------------------------------------
+
+//A state machine has a set of states, a set of events, and a list of transitions.
+//Each transition says that if the machine is in a certain state and receives a certain event, it moves to another state and performs an action.
+//These are often written with a switch statement nested inside another switch statement, or with a class for each state and virtual functions.
+//Instead, we'll describe each transition as a type, and have the compiler turn the whole list into a lookup table.
+
+//Template parameters declared with auto (added in C++17) are non-type parameters whose type is deduced from the argument,
+//so a transition can use any enum for its states and events:
+
+struct no_action{
+    template<typename Context>
+    void operator()(Context&) const {}
+};
+
+template<auto From, auto Event, auto To, typename Action = no_action>
+struct transition{
+    static constexpr auto from = From;
+    static constexpr auto event = Event;
+    static constexpr auto to = To;
+    using action = Action;
+};
+
+//The state machine takes the types of its states and events, followed by the transitions.
+//The enums need to have a last enumerator called count, so the state machine knows how big to make the table.
+
+template<typename State, typename Event, typename ...Transitions>
+class state_machine{
+public:
+
+    static constexpr size_t state_count = static_cast<size_t>(State::count);
+    static constexpr size_t event_count = static_cast<size_t>(Event::count);
+
+    static_assert(((std::is_same_v<std::remove_const_t<decltype(Transitions::from)>, State> &&
+                    std::is_same_v<std::remove_const_t<decltype(Transitions::to)>, State> &&
+                    std::is_same_v<std::remove_const_t<decltype(Transitions::event)>, Event>) && ...),
+                  "every transition must use the state machine's state and event types");
+
+    static_assert(((static_cast<size_t>(Transitions::from) < state_count && static_cast<size_t>(Transitions::to) < state_count &&
+                    static_cast<size_t>(Transitions::event) < event_count) && ...),
+                  "transitions can't use count as a state or an event");
+
+    explicit state_machine(State initial): current(initial){}
+
+    State state() const {return current;}
+
+    //Returns false if there's no transition for this event from the current state.
+    template<typename Context>
+    bool process(Event e, Context& ctx){
+        assert(static_cast<size_t>(e) < event_count && "count isn't a real event");
+        int index = table[static_cast<size_t>(current) * event_count + static_cast<size_t>(e)];
+        if(index < 0){return false;}
+        dispatch(index, ctx, std::index_sequence_for<Transitions...>{});
+        return true;
+    }
+
+private:
+
+    //The table has an entry for every (state, event) pair, holding the position of the matching transition in the pack, or -1 if there isn't one.
+    //It's built by a constexpr lambda, so the whole thing is computed while compiling.
+    static constexpr std::array<int, state_count * event_count> table = []{
+        std::array<int, state_count * event_count> result{};
+        for(int& entry : result){entry = -1;}
+        int index = 0;
+        ((result[static_cast<size_t>(Transitions::from) * event_count + static_cast<size_t>(Transitions::event)] = index++), ...);
+        return result;
+    }();
+
+    //Two transitions for the same state and event would mean the machine doesn't know which one to take,
+    //so every pair is compared with every other pair while compiling.
+    static constexpr bool unique_transitions = []{
+        constexpr size_t keys[] = {static_cast<size_t>(Transitions::from) * event_count + static_cast<size_t>(Transitions::event)..., 0};
+        for(size_t i = 0; i < sizeof...(Transitions); ++i){
+            for(size_t j = i + 1; j < sizeof...(Transitions); ++j){
+                if(keys[i] == keys[j]){return false;}
+            }
+        }
+        return true;
+    }();
+
+    static_assert(unique_transitions, "two transitions have the same state and event");
+
+    template<typename T, typename Context>
+    void fire(Context& ctx){
+        current = T::to;
+        if constexpr(!std::is_same_v<typename T::action, no_action>){typename T::action{}(ctx);}
+    }
+
+    template<typename Context, size_t ...Is>
+    void dispatch(int index, Context& ctx, std::index_sequence<Is...>){
+        ((index == static_cast<int>(Is) ? (fire<Transitions>(ctx), true) : false) || ...);
+    }
+
+    State current;
+};
+
+//The table lookup finds which transition to take. dispatch then expands into a chain of comparisons, one per transition,
+//which stops at the first one that matches since || short circuits. The compiler sees a comparison of index against
+//consecutive constants, so it usually turns this into a jump table, just like a switch statement.
+//fire uses if constexpr so that transitions without an action don't generate any code for it at all.
+//Since nothing is virtual and every action's type is known, each action can be inlined directly into the dispatch.
+
+//Here's a state machine for a simple message protocol. A message is a header followed by any number of data packets, then an end marker:
+
+enum class parser_state{idle, header, body, count};
+enum class parser_event{start, data, end, count};
+
+struct message_context{
+    int messages = 0;
+    int packets = 0;
+};
+
+struct count_packet{
+    void operator()(message_context& ctx) const {++ctx.packets;}
+};
+
+struct finish_message{
+    void operator()(message_context& ctx) const {++ctx.messages;}
+};
+
+using message_parser = state_machine<parser_state, parser_event,
+    transition<parser_state::idle, parser_event::start, parser_state::header>,
+    transition<parser_state::header, parser_event::data, parser_state::body, count_packet>,
+    transition<parser_state::body, parser_event::data, parser_state::body, count_packet>,
+    transition<parser_state::body, parser_event::end, parser_state::idle, finish_message>
+>;
+
+//If two transitions have the same state and event, the static_assert in state_machine makes it a build error.
+//For example, adding transition<parser_state::body, parser_event::data, parser_state::idle> to the list above wouldn't compile.
+//Any event that doesn't have a transition from the current state is rejected, and the state doesn't change.
+//The extra 0 at the end of keys is only there so the array isn't empty when there are no transitions.
+
+
+
+int main(){
+
+    std::cout << factorial<10>::value << std::endl;
+
+    message_parser parser(parser_state::idle);
+    message_context ctx;
+
+    parser_event events[] = {parser_event::start, parser_event::data, parser_event::data, parser_event::end,
+                             parser_event::end, parser_event::start, parser_event::data, parser_event::end};
+
+    for(parser_event e : events){
+        if(!parser.process(e, ctx)){std::cout << "Unexpected event\n";}
+    }
+
+    std::cout << ctx.messages << " messages, " << ctx.packets << " packets\n";
+
+    return 0;
+}
@@ -1,6 +1,18 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 //--------------------------------------------------
 //EXPLICIT TEMPLATE SPECIALIZATION
@@ -341,6 +353,210 @@ struct H{
 
 //Additional methods to explicitly specialize members will be discussed in the SFINAE section.
 
+//--------------------------------------------------
+//CHOOSING AN IMPLEMENTATION WITH TRAITS
+//--------------------------------------------------
+
+//A common use of specialization is a "traits" class: a class template whose only job is to give you the right
+//type, constant, or function for a given template argument. std::hash is an example. A hash table that wants to hash a key
+//of type K uses std::hash<K>, and whoever writes the type K specializes std::hash for it.
+//You can also specialize a traits class to replace a default that doesn't suit what you're doing.
+//For example, std::hash<int> usually just returns the int unchanged. That's a problem for a hash table that only looks at the low bits
+//of the hash to pick a bucket, since keys like 16, 32, 48... would all land in the same bucket.
+//A partial specialization can fix that for every integer type at once, by adding a defaulted bool parameter to the primary template:
+
+template<typename T, bool = std::is_integral_v<T>>
+struct guide_hash{
+    size_t operator()(const T& val) const {return std::hash<T>{}(val);}
+};
+
+template<typename T>
+struct guide_hash<T, true>{
+    size_t operator()(T val) const {
+        uint64_t x = static_cast<uint64_t>(val);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+    }
+};
+
+//Nobody ever writes the bool argument themselves: guide_hash<int> fills it in as guide_hash<int, true>, which matches the
+//partial specialization, while guide_hash<std::string> becomes guide_hash<std::string, false> and uses the primary template.
+//The specialization mixes the bits of the integer so that every bit of the input affects the low bits of the output.
+
+//Here's a hash map that uses guide_hash by default. It's a simplified version of the "Swiss table" design.
+//Instead of a linked list per bucket, the keys and values are stored directly in one array, and a separate array holds one
+//control byte per slot. A control byte is negative if the slot is empty or deleted; otherwise, it holds 7 bits of the key's hash.
+//To look up a key, the map compares 16 control bytes at a time against those 7 bits, and only compares the actual keys
+//for the slots that match. With SSE2 (which every x86-64 processor has) comparing 16 bytes is a single instruction.
+//To let several threads use the map at once, it's split into shards, each with its own lock, and the hash picks the shard.
+
+template<typename K, typename V, typename Hash = guide_hash<K>>
+class concurrent_flat_map{
+public:
+
+    void insert_or_assign(const K& key, const V& val){assign(key, val);}
+    void insert_or_assign(K&& key, V&& val){assign(std::move(key), std::move(val));}
+
+    //Returns a copy of the value, since a reference could be invalidated by another thread as soon as the lock is released.
+    std::optional<V> find(const K& key) const {
+        size_t hash = Hash{}(key);
+        const shard& s = shards[shardIndex(hash)];
+        std::shared_lock<std::shared_mutex> lock(s.mutex);
+        size_t index = s.find(key, hash);
+        if(index == npos){return std::nullopt;}
+        return s.slots[index].second;
+    }
+
+    bool erase(const K& key){
+        size_t hash = Hash{}(key);
+        shard& s = shards[shardIndex(hash)];
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        size_t index = s.find(key, hash);
+        if(index == npos){return false;}
+        s.control[index] = deleted_byte;
+        s.slots[index] = std::pair<K, V>(); //destroys the old key and value now, instead of whenever the slot gets reused
+        --s.size;
+        ++s.deleted;
+        return true;
+    }
+
+private:
+
+    //Both versions of insert_or_assign share this. The key and value are forwarded, so the rvalue version moves them into the slot.
+    template<typename KK, typename VV>
+    void assign(KK&& key, VV&& val){
+        size_t hash = Hash{}(key);
+        shard& s = shards[shardIndex(hash)];
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        size_t index = s.find(key, hash);
+        if(index != npos){s.slots[index].second = std::forward<VV>(val); return;}
+        if((s.size + s.deleted + 1) * 8 > s.control.size() * 7){s.rehash(s.size * 2 >= s.control.size() / 2 ? s.control.size() * 2 : s.control.size());}
+        s.insert(std::forward<KK>(key), std::forward<VV>(val), hash);
+    }
+
+    static constexpr size_t shard_count = 16;
+    static constexpr size_t group_size = 16;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr int8_t empty_byte = -128;
+    static constexpr int8_t deleted_byte = -2;
+
+    //Returns a bitmask with bit i set if control byte i of the group equals byte.
+    static uint32_t matchByte(const int8_t* group, int8_t byte){
+#if defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte))));
+#else
+        uint32_t mask = 0;
+        for(size_t i = 0; i < group_size; ++i){if(group[i] == byte){mask |= 1u << i;}}
+        return mask;
+#endif
+    }
+
+    //Returns a bitmask of the slots in the group that are empty or deleted, which are the only negative control bytes.
+    static uint32_t matchFree(const int8_t* group){
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        uint32_t mask = 0;
+        for(size_t i = 0; i < group_size; ++i){if(group[i] < 0){mask |= 1u << i;}}
+        return mask;
+#endif
+    }
+
+    static size_t lowestBit(uint32_t mask){
+        size_t i = 0;
+        while(!(mask & 1u)){mask >>= 1; ++i;}
+        return i;
+    }
+
+    static size_t shardIndex(size_t hash){return (hash >> (sizeof(size_t) * 8 - 8)) % shard_count;}
+
+    struct alignas(64) shard{
+
+        shard(): control(group_size, empty_byte), slots(group_size){}
+
+        //Returns the index of the slot holding key, or npos if it's not in the shard.
+        size_t find(const K& key, size_t hash) const {
+            size_t groups = control.size() / group_size;
+            size_t group = (hash >> 7) & (groups - 1);
+            int8_t tag = static_cast<int8_t>(hash & 0x7f);
+            for(size_t probe = 0; probe < groups; ++probe){
+                const int8_t* bytes = &control[group * group_size];
+                for(uint32_t mask = matchByte(bytes, tag); mask != 0; mask &= mask - 1){
+                    size_t index = group * group_size + lowestBit(mask);
+                    if(slots[index].first == key){return index;}
+                }
+                if(matchByte(bytes, empty_byte) != 0){return npos;}
+                group = (group + 1) & (groups - 1);
+            }
+            return npos;
+        }
+
+        //Puts a key that isn't in the shard yet into the first free slot along its probe sequence.
+        template<typename KK, typename VV>
+        void insert(KK&& key, VV&& val, size_t hash){
+            size_t groups = control.size() / group_size;
+            size_t group = (hash >> 7) & (groups - 1);
+            while(true){
+                uint32_t mask = matchFree(&control[group * group_size]);
+                if(mask != 0){
+                    size_t index = group * group_size + lowestBit(mask);
+                    if(control[index] == deleted_byte){--deleted;}
+                    control[index] = static_cast<int8_t>(hash & 0x7f);
+                    slots[index].first = std::forward<KK>(key);
+                    slots[index].second = std::forward<VV>(val);
+                    ++size;
+                    return;
+                }
+                group = (group + 1) & (groups - 1);
+            }
+        }
+
+        void rehash(size_t capacity){
+            std::vector<int8_t> old_control(capacity, empty_byte);
+            std::vector<std::pair<K, V>> old_slots(capacity);
+            old_control.swap(control);
+            old_slots.swap(slots);
+            size = 0;
+            deleted = 0;
+            for(size_t i = 0; i < old_control.size(); ++i){
+                if(old_control[i] >= 0){
+                    size_t hash = Hash{}(old_slots[i].first);
+                    insert(std::move(old_slots[i].first), std::move(old_slots[i].second), hash);
+                }
+            }
+        }
+
+        mutable std::shared_mutex mutex;
+        std::vector<int8_t> control;
+        std::vector<std::pair<K, V>> slots;
+        size_t size = 0;
+        size_t deleted = 0;
+    };
+
+    std::array<shard, shard_count> shards;
+};
+
+//The 7 bits of the hash in the control byte (the low bits) and the bits that pick the starting group are different bits,
+//so keys that start in the same group usually still have different control bytes. The shard is picked with the highest 8 bits,
+//wherever those are: shifting by 56 would be undefined behavior on a platform where size_t is only 32 bits.
+//The capacity of each shard is always a power of two times 16, so the starting group can be found with a mask.
+//A lookup stops as soon as it sees a group with an empty slot in it, since the key would have been put there if it had gotten that far.
+//Deleted slots are different from empty ones for this reason: marking a slot as empty could cut off the probe sequence of another key.
+//When the shard gets 7/8 full (counting deleted slots) it's rebuilt, doubling in size if it's actually full of keys, or staying
+//the same size if most of the used slots were deleted.
+//find takes a shared lock, so any number of threads can read the same shard at once, while writers take the shard's lock exclusively.
+//Taking even a shared lock writes to the mutex (to count the readers), so each shard is aligned to its own 64 byte cache line.
+//Otherwise, neighboring shards' mutexes would share a cache line, and readers of different shards would keep taking it away from each other.
+//Rehashing moves the keys and values into the new slots instead of copying them, and the rvalue insert_or_assign moves them in too.
+//Since the slots array is created up front, K and V need to be default constructible.
+
+
+
 int main(){
     
     
@@ -348,5 +564,11 @@ int main(){
     H<size_t> obj;
     obj.func(5);
     
+    concurrent_flat_map<int, std::string> map; //Uses guide_hash<int, true>
+    map.insert_or_assign(16, "sixteen");
+    map.insert_or_assign(32, "thirty-two");
+    map.erase(16);
+    std::cout << map.find(16).value_or("not found") << ' ' << map.find(32).value_or("not found") << std::endl;
+    
     return 0;
 }